@@ -21,8 +21,56 @@ static constexpr int simMultiplier = 2;
 static constexpr float simSpeed = 0.5;
 /// @brief Simulation tick.
 static constexpr int simTick = 60;
+/// @brief Runs the physics at a fixed rate (simTick ticks of simMultiplier steps per second) instead of a wall-clock delta.
+static constexpr bool fixedTimestep = true;
+/// @brief Maximum number of ticks caught up at once by the fixed timestep loop, the rest is dropped.
+static constexpr int maxSimTicksCatchUp = 5;
 /// @brief Numerical epsilon used in collision/math comparisons.
 static constexpr float physicsEpsilon = 0.00001f;
+/// @brief Side of a spatial grid cell, in world units.
+static constexpr float gridCellSize = 8.f;
+/// @brief Number of hash buckets used by the spatial grid, rounded up to a power of two.
+static constexpr unsigned int gridBucketCount = 4096;
+/// @brief Iterations of the sequential impulse contact solver.
+static constexpr int solverIterations = 8;
+/// @brief Fraction of the penetration the contact solver recovers per step.
+static constexpr float contactBaumgarte = 0.2f;
+/// @brief Penetration tolerated by the contact solver, avoids contacts flickering at rest.
+static constexpr float contactSlop = 0.01f;
+/// @brief Approach velocity under which contacts do not bounce.
+static constexpr float restitutionThreshold = 0.05f;
+/// @brief Fraction of the motion to the time of impact kept by continuous collision detection, stops short of the surface.
+static constexpr float ccdBackoff = 0.99f;
+/// @brief Velocity under which a moving entity is considered at rest.
+static constexpr float sleepVelocity = 0.01f;
+/// @brief Steps an island of entities must stay at rest before being put to sleep.
+static constexpr unsigned int sleepTicks = 60;
+/// @brief Simulates the moving entities far from the player less often, or not at all, see Physics::LodTier.
+static constexpr bool physicsLod = true;
+/// @brief Distance to the player, in world units, under which entities are simulated every step.
+static constexpr float lodNearDistance = 160.f;
+/// @brief Distance to the player, in world units, beyond which entities are frozen.
+static constexpr float lodFarDistance = 480.f;
+/// @brief Steps between two simulations of an entity in the far tier.
+static constexpr unsigned int lodFarInterval = 4;
+/// @brief Distance an entity must move past a tier's limit to leave it for a farther one, avoids switching back and forth.
+static constexpr float lodHysteresis = 16.f;
+/// @brief Threads running the narrow phase, 0 uses every worker of the thread pool, 1 keeps it on the physics thread.
+static constexpr unsigned int narrowPhaseThreads = 0;
+/// @brief Minimum number of candidate pairs handed to one narrow phase worker.
+static constexpr unsigned int narrowPhaseBatchSize = 256;
+/// @brief Contact events held by the ring drained by the other threads, rounded up to a power of two.
+static constexpr unsigned int contactEventCapacity = 4096;
+/// @brief Makes the physics thread wait for the contact events consumer when the ring is full, instead of dropping events.
+static constexpr bool contactEventsWait = false;
+/// @brief Axis tests kept by the collision trace, the oldest ones being overwritten, see JUICE_COLLISION_TRACE.
+static constexpr unsigned int collisionTraceRecords = 1 << 20;
+/// @brief Largest distance, in world units, between a traced outline and the collision shape simplified from it.
+static constexpr float outlineSimplifyTolerance = 0.02f;
+/// @brief Largest angle, in radians, between two borders merged as collinear, or two normals giving the same SAT axis.
+static constexpr float outlineAngleTolerance = 0.02f;
+/// @brief Largest number of convex parts a collision shape is decomposed in, its convex hull is used beyond.
+static constexpr unsigned int outlineMaxConvexParts = 8;
 /// @brief Minimum scaling option when rendering the window.
 static constexpr float renderingScaleMin = 0.3f;
 /// @brief Maximum scaling option when rendering the window.
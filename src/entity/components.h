@@ -61,6 +61,36 @@ struct AABB
     }
 };
 
+/**
+ * @brief World-space bounding box of an entity, its @ref AABB translated by its position.
+ * @note Refreshed by Physics::Engine::updateWorldBounds at the beginning of every step, from the positions left by the
+ * integration and the continuous sweep of the previous step. The contact solver only changes velocities, the bounds
+ * stay valid until the next integration.
+ */
+struct WorldAABB
+{
+    /// @brief Bounds in world space.
+    AABB bounds{};
+};
+
+/**
+ * @brief Collision layers of an entity.
+ * Two entities may only collide when each one's category is in the other's mask.
+ */
+struct CollisionLayers
+{
+    /// @brief Layers the entity belongs to, one bit per layer.
+    uint32_t category = 1;
+    /// @brief Layers the entity collides with.
+    uint32_t mask = ~uint32_t(0);
+
+    /// @brief Returns true when the two entities' layers allow them to collide.
+    _nodiscard constexpr auto accepts(const CollisionLayers &other) const noexcept -> bool
+    {
+        return (category & other.mask) != 0 && (other.category & mask) != 0;
+    }
+};
+
 /**
  * @brief Aggregated linear and angular force result.
  */
@@ -99,10 +129,10 @@ struct Thrust
 
 struct PhysicsBounds
 {
-    /// @brief Vectors representing the bounds of the entity.
-    std::vector<glm::vec2> borders{};
-    /// @brief Vectors corresponding to the normals associated to each vector in @variable borders.
-    std::vector<glm::vec2> normals{};
+    /// @brief Id of the entity's outline in the scene's Physics::ShapePool, shared with the entities of the same shape.
+    uint32_t shape = 0;
+    /// @brief Scale applied to the outline along each axis.
+    glm::vec2 scale{1.f, 1.f};
 };
 
 struct PhysicsSetup
@@ -120,6 +150,8 @@ struct PhysicsSetup
     bool canCollide = true;
     /// @brief Tells if the object is affected by gravity or not.
     bool isNotFixed = true;
+    /// @brief Sweeps the entity's motion against fixed entities when it moves further than its extent in a step.
+    bool continuous = false;
 };
 
 struct PhysicsConstraints
@@ -151,12 +183,43 @@ struct PhysicsCartesianState
     glm::vec2 temporaryVelocities{};
 };
 
+/**
+ * @brief Forces applied to the entity until the next step, reduced as they are applied.
+ * Only the net force and torque are kept, so applying a force does not allocate.
+ */
 struct PhysicsForces
 {
-    /// @brief Active thrust forces to apply this frame.
-    std::vector<Thrust> thrusts{};
-    /// @brief Active torques to apply this frame.
-    std::vector<float> torques{};
+    /// @brief Sum of the thrusts applied this frame.
+    glm::vec2 force{};
+    /// @brief Sum of the torques applied this frame, thrusts off the center included.
+    float torque = 0.f;
+    /// @brief Number of thrusts and torques applied this frame.
+    uint16_t count = 0;
+
+    /// @brief Adds @param value, applied at the center, so without torque.
+    void add(const glm::vec2 value) noexcept
+    {
+        force += value;
+        ++count;
+    }
+    /// @brief Adds @param thrust, its point creating a torque around @param center.
+    void add(const Thrust &thrust, const glm::vec2 center) noexcept
+    {
+        const glm::vec2 arm{thrust.point.x - center.x, thrust.point.y - center.y};
+        force += glm::vec2{thrust.vector.x, thrust.vector.y};
+        torque += arm.x * thrust.vector.y - thrust.vector.x * arm.y;
+        ++count;
+    }
+    /// @brief Adds a pure torque of @param value.
+    void add(const float value) noexcept
+    {
+        torque += value;
+        ++count;
+    }
+    /// @brief Tells if nothing was applied this frame.
+    _nodiscard constexpr auto empty() const noexcept -> bool { return count == 0; }
+    /// @brief Removes everything applied, once the step consumed it.
+    void clear() noexcept { *this = PhysicsForces{}; }
 };
 
 struct PhysicsObjectState
@@ -165,6 +228,19 @@ struct PhysicsObjectState
     uint32_t id = -1;
     /// @brief Indicates whether this entity has collision geometry.
     bool hasCollision = false;
+    /// @brief Sleeping entities are neither integrated nor tested against other sleeping or fixed entities.
+    bool asleep = false;
+    /// @brief Consecutive steps the entity spent under Config::sleepVelocity, up to Config::sleepTicks.
+    uint16_t calmTicks = 0;
+    /// @brief Level of detail tier, by distance to the player, see Physics::LodTier.
+    uint8_t lodTier = 0;
+    /// @brief Steps simulated at once during this step, 0 when the level of detail skips the entity.
+    uint16_t lodSteps = 1;
+    /// @brief Steps skipped by the level of detail since the entity was last simulated.
+    uint16_t lodPending = 0;
+
+    /// @brief Tells if the entity is integrated and tested against fixed entities during this step.
+    _nodiscard constexpr auto simulated() const noexcept -> bool { return !asleep && lodSteps != 0; }
 };
 
 /**
@@ -195,8 +271,16 @@ struct CollisionInfo
     float depth = 0.f;
 };
 
-using PhysicsEntity
-    = TypesSet<PhysicsSetup, PhysicsObjectState, PhysicsBounds, AABB, PhysicsConstraints, PhysicsForces, PhysicsCartesianState, PhysicsAngularState>;
+using PhysicsEntity = TypesSet<PhysicsSetup,
+                               PhysicsObjectState,
+                               PhysicsBounds,
+                               AABB,
+                               WorldAABB,
+                               CollisionLayers,
+                               PhysicsConstraints,
+                               PhysicsForces,
+                               PhysicsCartesianState,
+                               PhysicsAngularState>;
 using GraphicsEntity = TypesSet<ObjectInformation, ObjectState, AnimationState>;
 
 } // namespace Entity
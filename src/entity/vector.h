@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <iterator>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -373,6 +374,19 @@ public:
         return std::get<I>(std::move(m_data));
     }
 
+    /* Single-column span: vec.column<T>() views the contiguous storage of column T */
+
+    template<typename T>
+    auto column() & -> std::span<T>
+    {
+        return std::get<type_index_v<T, Types...>>(m_data);
+    }
+    template<typename T>
+    _nodiscard auto column() const& -> std::span<const T>
+    {
+        return std::get<type_index_v<T, Types...>>(m_data);
+    }
+
     /* visit() — calls visitor.visit(colA[i], colB[i], ...) for each row */
 
     template<typename V>
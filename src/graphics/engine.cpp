@@ -12,6 +12,7 @@
 
 #include <cassert>
 #include <chrono>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <thread>
@@ -137,6 +138,8 @@ void Engine::init()
     assert(m_loadedEngine == nullptr);
     m_loadedEngine = this;
 
+    m_drawPhysics = getenv("JUICE_DEBUG_PHYSICS") != nullptr;
+
     initSDL();
     initVulkan();
     initVMA();
@@ -1135,20 +1138,26 @@ void Engine::run(const std::function<void()> &prepare, std::atomic<uint64_t> &co
         ImGui::Begin("Stats");
         ImGui::Text("Frame time %f ms", frameTime);
         ImGui::Text("Switches ratio %f", static_cast<float>(m_objCount) / static_cast<float>(m_switchesCount));
+        ImGui::Text("Physics latency %f ms", m_scene->snapshots.latency().count());
+        ImGui::Text("Physics snapshots skipped %llu", static_cast<unsigned long long>(m_scene->snapshots.skipped()));
         ImGui::End();
 
         ImGui::Render();
 
-        // Request the data to be updated before drawing.
-        commands |= PrepareDrawing;
-        while (!(commands & (DrawingPrepared | Stop))) {
-            // Wait for the submitted work request to be performed & finished.
-            // As this loop runs for the rendering, there are no reasons to
-            // redraw what's already on the screen. The only reason would be for
-            // the animations. So far, this runs smoothly enough.
+        // Newest positions published by the physics thread, never waited for.
+        m_scene->snapshots.consume();
+
+        /* Blend the last tick, advancing its alpha by the time elapsed since it was published */ {
+            const auto &snapshot = m_scene->snapshots.front();
+            // Nothing was published yet, the objects are still where the map placed them.
+            if (snapshot.published != std::chrono::steady_clock::time_point{}) {
+                const auto elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - snapshot.published).count();
+                const auto alpha = std::min(snapshot.alpha + elapsed * static_cast<float>(Config::simTick), 1.f);
+                for (size_t i = 0; i < snapshot.positions.size(); ++i) {
+                    m_scene->objects[m_scene->dynamicObjects[i]].position = glm::vec4(glm::mix(snapshot.previous[i], snapshot.positions[i], alpha), 0.f, 1.f);
+                }
+            }
         }
-        // Reset state.
-        commands &= ~DrawingPrepared;
 
         //updateAnimations(*m_scene);
         updateAnimations2(m_scene);
@@ -1236,7 +1245,9 @@ void Engine::draw()
     Utils::transitionImage(cmd, m_depthImage.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL);
 
     drawGeometry2(cmd);
-    //drawPhysics2(cmd);
+    if (m_drawPhysics) {
+        drawPhysics2(cmd);
+    }
     //drawPoints2(cmd);
 
     //transtion the draw image and the swapchain image into their correct transfer layouts
@@ -1397,6 +1408,27 @@ public:
         }
     }
 
+    /// @brief Draws the colliders made of merged tiles, which have no object of their own.
+    static void drawMergedBoxes2(const Engine &engine, GPUDrawLinePushConstants &pushConstants, const VkCommandBuffer cmd)
+        __attribute__((always_inline))
+    {
+        const auto &scene = *engine.m_scene;
+        const auto &resources = *scene.resources;
+
+        vkCmdBindIndexBuffer(cmd, resources.linesBuffer.indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
+
+        for (size_t i = scene.firstMergedEntity; i < scene.entities.size(); ++i) {
+            const auto [cState, box, objState] = scene.entities.at<Entity::PhysicsCartesianState, Entity::AABB, Entity::PhysicsObjectState>(i);
+
+            // Unit square scaled to the box, yellow to tell them from the tiles' outlines.
+            pushConstants.color = objState.hasCollision ? glm::vec3(1.f, 0.f, 0.f) : glm::vec3(1.f, 1.f, 0.f);
+            pushConstants.worldMatrix = glm::scale(glm::translate(engine.worldMatrix, glm::vec3(cState.position, 0.f)), glm::vec3(box.max - box.min, 1.f));
+
+            vkCmdPushConstants(cmd, engine.m_linePipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(GPUDrawLinePushConstants), &pushConstants);
+            vkCmdDrawIndexed(cmd, Resources::boxBorderCount, 1, resources.boxBorderOffset, 0, 0);
+        }
+    }
+
     /// @brief Draws chunk debug points.
     static void drawChunkPoints2(const Engine &engine, GPUDrawPointPushConstants &pushConstants, const VkCommandBuffer cmd)
         __attribute__((always_inline))
@@ -1528,6 +1560,7 @@ void Engine::drawPhysics2(const VkCommandBuffer cmd)
     };
 
     DrawingFuncs::drawChunkPhysics2(*this, pushConstants, cmd);
+    DrawingFuncs::drawMergedBoxes2(*this, pushConstants, cmd);
 
     vkCmdEndRendering(cmd);
 }
@@ -1638,11 +1671,12 @@ auto Engine::uploadMesh(const std::span<const uint32_t> &indices, const std::spa
 
 void Engine::uploadObjectDataForDrawing()
 {
-    if (m_scene->entities.empty()) {
+    if (m_scene->objects.empty()) {
         return;
     }
 
-    const size_t elementsCount = m_scene->entities.size();
+    // Fixed entities may have been merged at load, there can be more objects than entities.
+    const size_t elementsCount = m_scene->objects.size();
 
     assert(elementsCount < Config::maximumObjectCount);
 
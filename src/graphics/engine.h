@@ -173,7 +173,7 @@ protected:
     /// @brief Draws scene geometry.
     void drawGeometry2(VkCommandBuffer cmd);
     // For debugging purposes.
-    /// @brief Draws physics debug overlays.
+    /// @brief Draws physics debug overlays, the outlines of the objects and of the merged colliders.
     void drawPhysics2(VkCommandBuffer cmd);
     /// @brief Draws point debug overlays.
     void drawPoints2(VkCommandBuffer cmd);
@@ -272,6 +272,8 @@ private:
     bool m_resizeRequested = false;
     /// @brief Render scale multiplier.
     float m_renderScale = 1.f;
+    /// @brief Draws the colliders over the scene, set by the JUICE_DEBUG_PHYSICS environment variable.
+    bool m_drawPhysics = false;
 
     /// @brief Queue of deferred cleanups executed at shutdown.
     DeletionQueue m_mainDeletionQueue{};
@@ -1,6 +1,7 @@
 #include "src/graphics/resources.h"
 
 #include <algorithm>
+#include <array>
 #include <span>
 
 #include "src/graphics/engine.h"
@@ -52,6 +53,12 @@ void Resources::build(const std::shared_ptr<Engine> &engine)
             i += static_cast<uint32_t>(v.size());
         }
 
+        // Same outline as the colliders of Physics::mergeStaticBoxes, scaled to each of them.
+        boxBorderOffset = i;
+        gpuBorders.resize(i + boxBorderCount);
+        std::ranges::copy(std::array<LineVertex, boxBorderCount>{{{{0.f, 0.f}}, {{0.f, 1.f}}, {{1.f, 1.f}}, {{1.f, 0.f}}, {{0.f, 0.f}}}},
+                          gpuBorders.begin() + i);
+
         gpuBorders.shrink_to_fit();
         const auto bordersCount = gpuBorders.size();
         assert(bordersCount != 0);
@@ -94,6 +101,7 @@ void Resources::cleanup(const std::shared_ptr<Engine> &engine)
     normals.clear();
     boundingBoxes.clear();
     borderOffsets.clear();
+    boxBorderOffset = 0;
     animations.clear();
     groupedImagesMapping.clear();
 
@@ -50,6 +50,10 @@ public:
     std::vector<std::vector<glm::vec2>> borders{};
     /// @brief Prefix offsets for packed border arrays.
     std::vector<uint32_t> borderOffsets{};
+    /// @brief Offset of the unit square packed after the borders, drawn for the merged colliders.
+    uint32_t boxBorderOffset = 0;
+    /// @brief Number of points of the unit square.
+    static constexpr uint32_t boxBorderCount = 5;
 
     /**
 	 * @brief Normals of the borders each resource.
@@ -234,7 +234,7 @@ struct AnimationData
  */
 struct ObjectData
 {
-    /// @brief Object unique identifier.
+    /// @brief Index of the object's physics entity, shared by the tiles merged in a single collider.
     GPU_EXPOSED(uint32_t, objId) = 0;
     /// @brief Id (offset) of the associated 6 vertices.
     GPU_EXPOSED(uint32_t, verticesId) = 0;
@@ -3,9 +3,12 @@
 
 #include <array>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "src/config.h"
+
 namespace Loaders
 {
 
@@ -40,6 +43,18 @@ struct JsonResourceElement
 	/// @brief Elesticity, bounciness of the resource.
 	float elasticity = 1.f;
 
+    /// @brief Collision layers the elements of this resource type belong to, one bit per layer.
+    uint32_t category = 1;
+    /// @brief Collision layers the elements of this resource type collide with.
+    uint32_t mask = ~uint32_t(0);
+
+    /// @brief Largest distance, in physical units, between the traced outline and the collision shape, 0 keeps every point.
+    float simplifyTolerance = Config::outlineSimplifyTolerance;
+    /// @brief Largest angle, in radians, under which borders are merged as collinear and normals give a single SAT axis.
+    float angleTolerance = Config::outlineAngleTolerance;
+    /// @brief Largest number of convex parts of the collision shape, its convex hull is used beyond.
+    uint16_t maxConvexParts = Config::outlineMaxConvexParts;
+
     /// @brief Animation's spritesheet grid size, ROW*COLUMNS
     std::array<float, 2> gridSize = {1.f, 1.f};
 
@@ -93,6 +108,12 @@ struct JsonChunkElement
     bool canCollide = true;
     /// @brief If the object is subject to gravity.
 	bool isNotFixed = true;
+    /// @brief Collision layers of the element, overrides the resource's category.
+    std::optional<uint32_t> category {};
+    /// @brief Layers the element collides with, overrides the resource's mask.
+    std::optional<uint32_t> mask {};
+    /// @brief If the object is fast and must not tunnel through thin fixed objects, see Entity::PhysicsSetup::continuous.
+    bool continuous = false;
 
 	// [TODO] See how to handle initial frictions, thrusts & torques...
 };
@@ -22,6 +22,9 @@
 #include "src/graphics/resources.h"
 #include "src/loaders/json.h"
 #include "src/loaders/packing.h"
+#include "src/physics/entity.h"
+#include "src/physics/outline.h"
+#include "src/physics/tilemerge.h"
 #include "src/threadpool.h"
 #include "src/world/scene.h"
 
@@ -38,9 +41,8 @@ Map::Map(std::string path)
     stbi_set_flip_vertically_on_load(true);
 }
 
-inline void copyValues2(decltype(std::views::concat(std::declval<JsonMap &>().movings, std::declval<JsonMap &>().chunks | std::views::join)) json,
-                        const JsonMap &map,
-                        const std::shared_ptr<World::Scene> &scene)
+template<std::ranges::random_access_range R>
+inline void copyValues2(R &&json, const JsonMap &map, const std::shared_ptr<World::Scene> &scene)
 {
     const auto entitiesCount = scene->entities.size();
 
@@ -50,6 +52,7 @@ inline void copyValues2(decltype(std::views::concat(std::declval<JsonMap &>().mo
     auto pAStateRange = scene->entities.range<Entity::PhysicsAngularState>();
     auto pBoundsRange = scene->entities.range<Entity::PhysicsBounds>();
     auto pBBoxRange = scene->entities.range<Entity::AABB>();
+    auto pLayersRange = scene->entities.range<Entity::CollisionLayers>();
     //auto pCStateRange = scene->entities.range<Entity::PhysicsCartesianState>();
 
     for (const auto &[entity, element] : std::views::zip(pSetupRange, json)) {
@@ -68,6 +71,18 @@ inline void copyValues2(decltype(std::views::concat(std::declval<JsonMap &>().mo
         std::get<0>(entity).isNotFixed = element.isNotFixed;
     }
 
+    for (const auto &[entity, element] : std::views::zip(pSetupRange, json)) {
+        std::get<0>(entity).continuous = element.continuous;
+    }
+
+    for (const auto &[entity, element] : std::views::zip(pLayersRange, json)) {
+        const auto &resource = map.resources[element.type];
+        std::get<0>(entity) = Entity::CollisionLayers{
+            .category = element.category.value_or(resource.category),
+            .mask = element.mask.value_or(resource.mask),
+        };
+    }
+
     for (const auto &[entity, element] : std::views::zip(pConstraintsRange, json)) {
         std::get<0>(entity).friction = element.friction;
     }
@@ -92,12 +107,31 @@ inline void copyValues2(decltype(std::views::concat(std::declval<JsonMap &>().mo
         std::get<0>(entity).angularVelocity = element.angularVelocity;
     }
 
-    for (const auto &[entity, element] : std::views::zip(pBoundsRange, json)) {
-        std::get<0>(entity).borders = scene->resources->borders[element.type];
-    }
+    /* Every entity of a resource shares its outline, simplified and split in convex parts */ {
+        const auto &resources = *scene->resources;
+        std::vector<uint32_t> resourceShapes(resources.borders.size());
+        size_t tracedAxes = 0;
+        size_t shapeAxes = 0;
+
+        for (size_t type = 0; type < resourceShapes.size(); ++type) {
+            const auto &resource = map.resources[type];
+            const auto parts = Physics::buildConvexParts(resources.borders[type],
+                                                         Physics::OutlineTolerances{
+                                                             .simplify = resource.simplifyTolerance,
+                                                             .angle = resource.angleTolerance,
+                                                             .maxParts = resource.maxConvexParts,
+                                                         });
+
+            resourceShapes[type] = scene->shapes.intern(parts);
+            tracedAxes += resources.normals[type].size();
+            shapeAxes += scene->shapes.shape(resourceShapes[type]).normals.size();
+        }
+
+        std::cout << "Collision axes: " << tracedAxes << " traced, " << shapeAxes << " after simplification\n";
 
-    for (const auto &[entity, element] : std::views::zip(pBoundsRange, json)) {
-        std::get<0>(entity).normals = scene->resources->normals[element.type];
+        for (const auto &[entity, element] : std::views::zip(pBoundsRange, json)) {
+            std::get<0>(entity) = Entity::PhysicsBounds{.shape = resourceShapes[element.type]};
+        }
     }
 
     for (const auto &[entity, element] : std::views::zip(pBBoxRange, json)) {
@@ -620,11 +654,23 @@ auto Map::load2(const std::shared_ptr<Graphics::Engine> &engine, const std::shar
 
     auto flattenedChunks = std::views::concat(map.movings, map.chunks | std::views::join);
 
-    const auto entitiesCount = std::accumulate(map.chunks.cbegin(), map.chunks.cend(), 0, [](const size_t prev, const auto &chunk) -> size_t {
+    const auto entitiesCount = std::accumulate(map.chunks.cbegin(), map.chunks.cend(), map.movings.size(), [](const size_t prev, const auto &chunk) -> size_t {
         return prev + chunk.size();
     });
 
+    // Moving entities first, the physics engine only walks them every tick.
+    std::vector<const JsonChunkElement *> ordered{};
+    ordered.reserve(entitiesCount);
+    for (const auto &element : flattenedChunks) {
+        ordered.push_back(&element);
+    }
+    const auto fixedBegin = std::ranges::stable_partition(ordered, [](const JsonChunkElement *element) -> bool { return element->isNotFixed; }).begin();
+    scene->dynamicCount = static_cast<size_t>(std::distance(ordered.begin(), fixedBegin));
+
+    const auto elements = ordered | std::views::transform([](const JsonChunkElement *element) -> const JsonChunkElement & { return *element; });
+
     // We fill it in later to avoid constructing and then change the data.
+    scene->shapes.clear();
     scene->entities.resize(entitiesCount);
     scene->objects.resize(entitiesCount);
 
@@ -635,13 +681,13 @@ auto Map::load2(const std::shared_ptr<Graphics::Engine> &engine, const std::shar
     }
 
     // Set object positions
-    for (const auto &[chunkElement, obj] : std::views::zip(flattenedChunks, scene->objects)) {
+    for (const auto &[chunkElement, obj] : std::views::zip(elements, scene->objects)) {
         const auto pos = chunkElement.position;
         obj.position = glm::vec4(pos[0], pos[1], pos[2], 1.f);
     }
 
     // Set object animation IDs
-    for (const auto &[chunkElement, obj] : std::views::zip(flattenedChunks, scene->objects)) {
+    for (const auto &[chunkElement, obj] : std::views::zip(elements, scene->objects)) {
         // type is the resource index in map.resources; animations were created in
         // the same order, so use type directly as animationId.
         obj.animationId = static_cast<uint32_t>(chunkElement.type);
@@ -651,7 +697,33 @@ auto Map::load2(const std::shared_ptr<Graphics::Engine> &engine, const std::shar
     std::ranges::for_each(scene->objects, [](auto &obj) -> void { obj.transform = glm::mat4{1.f}; });
 
     // Update entities' information.
-    copyValues2(flattenedChunks, map, scene);
+    copyValues2(elements, map, scene);
+
+    // Rows of tiles become single colliders, objects keep drawing every tile.
+    const auto mergeReport = Physics::mergeStaticBoxes(scene->entities, scene->dynamicCount, scene->shapes);
+    std::cout << "Fixed colliders: " << mergeReport.before << " before merging tiles, " << mergeReport.after << " after\n";
+    scene->firstMergedEntity = mergeReport.firstMerged;
+
+    // Tiles point to the box they were merged in.
+    std::ranges::for_each(scene->objects, [&mergeReport](auto &obj) -> void { obj.objId = mergeReport.remap[obj.objId]; });
+
+    /* Shared shapes footprint, compared with a copy of the outline in each entity */ {
+        size_t copies = 0;
+        for (const auto &bounds : scene->entities.column<Entity::PhysicsBounds>()) {
+            copies += scene->shapes.bytes(bounds.shape) + 4 * sizeof(std::vector<glm::vec2>);
+        }
+        std::cout << "Collision shapes: " << scene->shapes.size() << " shared by " << scene->entities.size() << " entities, "
+                  << scene->shapes.memoryBytes() << " bytes, " << copies << " bytes as per-entity copies\n";
+    }
+
+    /* World bounds, never refreshed for fixed entities */ {
+        const auto cStates = scene->entities.column<Entity::PhysicsCartesianState>();
+        const auto boxes = scene->entities.column<Entity::AABB>();
+        const auto world = scene->entities.column<Entity::WorldAABB>();
+        for (size_t i = 0; i < world.size(); ++i) {
+            world[i].bounds = Physics::worldBounds(cStates[i], boxes[i]);
+        }
+    }
 
     /* Unique entity ID, different from object ID. */ {
         size_t i = 0;
@@ -668,6 +740,19 @@ auto Map::load2(const std::shared_ptr<Graphics::Engine> &engine, const std::shar
         chunkObjectsGrouping(scene);
     }
 
+    /* Objects drawn for the moving entities, objId being the entity index */ {
+        scene->dynamicObjects.resize(scene->dynamicCount);
+        for (size_t i = 0; i < scene->objects.size(); ++i) {
+            if (const auto objId = scene->objects[i].objId; objId < scene->dynamicCount) {
+                scene->dynamicObjects[objId] = static_cast<uint32_t>(i);
+            }
+        }
+        scene->snapshots.resize(scene->dynamicCount);
+    }
+
+    // Fixed entities never move, the physics engine only queries this tree for them.
+    scene->staticTree.build(scene->entities);
+
     return {Status::Ok, ""};
 }
 }
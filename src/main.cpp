@@ -22,7 +22,13 @@ auto main(const int argc, char **argv) -> int
     auto scene = std::make_shared<World::Scene>(chunks);
     Orchestrator orchestrator{};
 
-    if (const auto error = orchestrator.loadMap(scene, "/home/nicolas/Documents/repos/github/juice-power/maps/0"); std::get<0>(error) != Loaders::Status::Ok) {
+    // Allows running the benchmark maps, e.g. maps/stack.
+    const char *mapPath = getenv("JUICE_MAP");
+    if (mapPath == nullptr) {
+        mapPath = "/home/nicolas/Documents/repos/github/juice-power/maps/0";
+    }
+
+    if (const auto error = orchestrator.loadMap(scene, mapPath); std::get<0>(error) != Loaders::Status::Ok) {
         std::cerr << "Erreur: " << magic_enum::enum_name(std::get<0>(error)) << ": " << std::get<1>(error) << '\n';
         return 0;
     }
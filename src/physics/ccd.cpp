@@ -0,0 +1,55 @@
+#include "src/physics/ccd.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Physics
+{
+
+auto timeOfImpact(const Entity::AABB &moving, const glm::vec2 displacement, const Entity::AABB &target, glm::vec2 &normal) noexcept -> float
+{
+    float entry = 0.f;
+    float exit = 1.f;
+    normal = {};
+
+    // Slabs of the Minkowski difference, one axis after the other.
+    for (int axis = 0; axis < 2; ++axis) {
+        const float d = displacement[axis];
+        const float toEnter = target.min[axis] - moving.max[axis];
+        const float toExit = target.max[axis] - moving.min[axis];
+
+        if (d == 0.f) {
+            // Never overlapping on this axis.
+            if (toEnter > 0.f || toExit < 0.f) {
+                return 1.f;
+            }
+            continue;
+        }
+
+        float t0 = toEnter / d;
+        float t1 = toExit / d;
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+
+        if (t0 > entry) {
+            entry = t0;
+            normal = {};
+            normal[axis] = d > 0.f ? -1.f : 1.f;
+        }
+        exit = std::min(exit, t1);
+
+        if (entry > exit) {
+            return 1.f;
+        }
+    }
+
+    // Overlapping from the start, the narrow phase handles it.
+    if (normal == glm::vec2{}) {
+        return 1.f;
+    }
+
+    return entry;
+}
+
+} // namespace Physics
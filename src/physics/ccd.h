@@ -0,0 +1,31 @@
+#ifndef JP_PHYSICS_CCD_H
+#define JP_PHYSICS_CCD_H
+
+#include <glm/vec2.hpp>
+
+#include "src/entity/components.h"
+#include "src/keywords.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Swept AABB test, returns the fraction of @param displacement after which @param moving touches @param target.
+ * @param normal Receives the face normal of @param target that is hit, pointing towards @param moving.
+ * @return 1 when the boxes do not meet during the displacement, or when they already overlap at its beginning.
+ */
+_nodiscard auto timeOfImpact(const Entity::AABB &moving, glm::vec2 displacement, const Entity::AABB &target, glm::vec2 &normal) noexcept -> float;
+
+/**
+ * @brief Returns true if a displacement of @param displacement moves an entity bounded by @param boundingBox
+ * further than its own extent, in which case it may tunnel through thin entities.
+ */
+_nodiscard constexpr auto needsSweep(const Entity::AABB &boundingBox, const glm::vec2 displacement) noexcept -> bool
+{
+    const auto extent = boundingBox.max - boundingBox.min;
+    return (displacement.x < 0.f ? -displacement.x : displacement.x) > extent.x || (displacement.y < 0.f ? -displacement.y : displacement.y) > extent.y;
+}
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_CCD_H
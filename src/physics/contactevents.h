@@ -0,0 +1,143 @@
+#ifndef JP_PHYSICS_CONTACTEVENTS_H
+#define JP_PHYSICS_CONTACTEVENTS_H
+
+#include <glm/vec2.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "src/config.h"
+#include "src/keywords.h"
+#include "src/physics/enums.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Contact between two entities reported by the physics thread, see ContactEventQueue.
+ */
+struct ContactEvent
+{
+    /// @brief Lowest entity index of the pair.
+    int a = 0;
+    /// @brief Highest entity index of the pair.
+    int b = 0;
+    /// @brief Contact normal, from a to b, zero for ended contacts and contacts carried over by sleeping pairs.
+    glm::vec2 normal{};
+    /// @brief Penetration depth.
+    float depth = 0.f;
+    /// @brief Impulse applied along the normal by the contact solver during the step.
+    float impulse = 0.f;
+    /// @brief Whether the contact begins, stays or ends.
+    ContactState kind = ContactState::Begin;
+};
+
+static_assert(std::is_trivially_copyable_v<ContactEvent>, "Contact events are copied in and out of the ring.");
+
+/**
+ * @brief Lock-free single producer, single consumer ring of contact events.
+ *
+ * The physics thread pushes the events of each step, one other thread drains them. Events are only pushed once the
+ * consumer subscribed, so a ring nobody reads neither fills up nor counts drops. The ring is allocated once, with a
+ * power of two capacity, pushing and draining never allocate. When the ring is full, @var ContactOverflow tells
+ * whether new events are dropped (and counted) or the physics thread waits for the consumer.
+ */
+class ContactEventQueue
+{
+public:
+    /// @brief Allocates room for @param capacity events, rounded up to a power of two.
+    explicit ContactEventQueue(const size_t capacity = Config::contactEventCapacity)
+        : m_events(std::bit_ceil(std::max<size_t>(capacity, 2)))
+        , m_mask(m_events.size() - 1)
+    {}
+
+    /// @brief Selects what @fn push does when the ring is full.
+    void setOverflow(const ContactOverflow overflow) noexcept { m_overflow.store(overflow, std::memory_order_relaxed); }
+    /// @brief Returns what @fn push does when the ring is full.
+    _nodiscard auto overflow() const noexcept -> ContactOverflow { return m_overflow.load(std::memory_order_relaxed); }
+
+    /// @brief Declares the consumer, nothing is pushed before, see @fn subscribed. Draining subscribes as well.
+    void subscribe() noexcept { m_subscribed.store(true, std::memory_order_relaxed); }
+    /// @brief Tells if a consumer subscribed, the producer skips the events otherwise.
+    _nodiscard auto subscribed() const noexcept -> bool { return m_subscribed.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Adds @param event, producer side.
+     * @return False when the ring was full and the event dropped.
+     */
+    auto push(const ContactEvent &event) noexcept -> bool
+    {
+        const auto head = m_head.load(std::memory_order_relaxed);
+
+        if (head - m_cachedTail > m_mask) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            while (head - m_cachedTail > m_mask) {
+                if (overflow() == ContactOverflow::Drop) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                std::this_thread::yield();
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+            }
+        }
+
+        m_events[head & m_mask] = event;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Calls @param fn with every event pushed so far, in order, consumer side.
+     * @return The number of events drained.
+     */
+    template<typename F>
+    auto drain(F &&fn) -> size_t
+    {
+        subscribe();
+
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        const auto head = m_head.load(std::memory_order_acquire);
+
+        for (auto i = tail; i != head; ++i) {
+            fn(m_events[i & m_mask]);
+        }
+
+        m_tail.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    /// @brief Returns the number of events the ring holds.
+    _nodiscard auto capacity() const noexcept -> size_t { return m_events.size(); }
+    /// @brief Returns the number of events dropped because the ring was full.
+    _nodiscard auto dropped() const noexcept -> uint64_t { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    /// @brief Events, indexed by the positions masked with @var m_mask.
+    std::vector<ContactEvent> m_events{};
+    /// @brief Capacity minus one.
+    size_t m_mask = 0;
+    /// @brief Behavior when full.
+    std::atomic<ContactOverflow> m_overflow = Config::contactEventsWait ? ContactOverflow::Wait : ContactOverflow::Drop;
+    /// @brief Events dropped.
+    std::atomic<uint64_t> m_dropped = 0;
+    /// @brief Set once a consumer subscribed.
+    std::atomic<bool> m_subscribed = false;
+
+    /// @brief Position of the next event pushed, written by the producer.
+    alignas(64) std::atomic<size_t> m_head = 0;
+    /// @brief Last value of @var m_tail seen by the producer, spares a shared cache line read per event.
+    size_t m_cachedTail = 0;
+
+    /// @brief Position of the next event drained, written by the consumer.
+    alignas(64) std::atomic<size_t> m_tail = 0;
+};
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_CONTACTEVENTS_H
@@ -6,6 +6,9 @@
 namespace Physics
 {
 
+/// @brief Vertical acceleration applied to every moving entity.
+static constexpr double gravity = -0.05;
+
 static constexpr auto timestep() -> float
 {
     return 1.f / Config::simTick / Config::simMultiplier * Config::simSpeed;
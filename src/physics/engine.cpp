@@ -1,15 +1,23 @@
 #include "src/physics/engine.h"
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <limits>
 #include <ranges>
+#include <thread>
 
 #include <ctrack.hpp>
 
+#include <magic_enum.hpp>
+
 #include "src/config.h"
 #include "src/input/defines.h"
+#include "src/physics/ccd.h"
+#include "src/physics/defines.h"
 #include "src/physics/entity.h"
 #include "src/states.h"
+#include "src/threadpool.h"
 
 namespace
 {
@@ -21,19 +29,66 @@ static auto prevChrono = std::chrono::system_clock::now();
 static Physics::ComputeState computeState{};
 }
 
-constexpr auto epsiloned(const auto &t)
-{
-    return t;
-}
-
 namespace Physics
 {
 
-Engine::Engine() = default;
+Engine::Engine()
+{
+    // Allows comparing the broad phases on the same map without rebuilding.
+    if (const char *name = getenv("JUICE_BROAD_PHASE"); name != nullptr) {
+        if (const auto broadPhase = magic_enum::enum_cast<BroadPhase>(name); broadPhase.has_value()) {
+            m_broadPhase = broadPhase.value();
+        } else {
+            std::cerr << "Unknown broad phase " << name << ", using " << magic_enum::enum_name(m_broadPhase) << '\n';
+        }
+    }
+    if (const char *cellSize = getenv("JUICE_GRID_CELL_SIZE"); cellSize != nullptr) {
+        if (const float value = std::strtof(cellSize, nullptr); value > 0.f) {
+            m_spatialGrid.setCellSize(value);
+        }
+    }
+    if (const char *iterations = getenv("JUICE_SOLVER_ITERATIONS"); iterations != nullptr) {
+        m_solver.setIterations(std::max(std::atoi(iterations), 0));
+    }
+    if (const char *name = getenv("JUICE_CONTACT_OVERFLOW"); name != nullptr) {
+        if (const auto overflow = magic_enum::enum_cast<ContactOverflow>(name); overflow.has_value()) {
+            m_contactEvents.setOverflow(overflow.value());
+        } else {
+            std::cerr << "Unknown contact overflow " << name << ", using " << magic_enum::enum_name(m_contactEvents.overflow()) << '\n';
+        }
+    }
+    // Records every axis tested, saved to this file when the simulation stops.
+    if (const char *path = getenv("JUICE_COLLISION_TRACE"); path != nullptr) {
+        m_tracePath = path;
+        m_trace.reserve(Config::collisionTraceRecords);
+    }
+    // Allows comparing the cost of large maps with and without the level of detail.
+    if (const char *lod = getenv("JUICE_PHYSICS_LOD"); lod != nullptr) {
+        m_levelOfDetail = std::atoi(lod) != 0;
+    }
+    // Allows measuring the narrow phase scaling from 1 to N threads.
+    if (const char *threads = getenv("JUICE_PHYSICS_THREADS"); threads != nullptr) {
+        m_narrowPhaseThreads = std::strtoul(threads, nullptr, 10);
+    }
+}
 
 void Engine::setScene(const std::shared_ptr<World::Scene> &scene)
 {
     m_scene = scene;
+    m_sweepAndPrune.reset();
+    m_spatialGrid.reset();
+    m_solver.reset();
+    m_axisCache.clear();
+}
+
+void Engine::setBroadPhase(const BroadPhase broadPhase)
+{
+    m_broadPhase = broadPhase;
+}
+
+void Engine::setGridCellSize(const float cellSize)
+{
+    m_spatialGrid.setCellSize(cellSize);
 }
 
 void Engine::setInputState(Input::InnerState &state)
@@ -44,6 +99,8 @@ void Engine::setInputState(Input::InnerState &state)
 void Engine::prepare()
 {
 	prevChrono = std::chrono::system_clock::now();
+    m_previousTime = std::chrono::steady_clock::now();
+    m_accumulator = {};
 }
 
 class DumpVisitor
@@ -89,82 +146,6 @@ constexpr auto rotate(const glm::vec2 &v, const double angle) -> glm::vec2
 	return glm::vec2 {v.x * c - v.y * s, v.x * s + v.y * c};
 }
 
-void Engine::resolveCollision(const int a, const int b, const Entity::CollisionInfo &info)
-{
-    using requiredFields = ReferencesSet<Entity::PhysicsSetup, Entity::PhysicsCartesianState>;
-
-    if (info.depth < Config::physicsEpsilon) {
-        return;
-    }
-
-    const auto &[a_Setup, a_cState] = m_scene->entities.at<requiredFields>(a);
-    const auto &[b_Setup, b_cState] = m_scene->entities.at<requiredFields>(b);
-
-    // Relative velocity
-    const glm::vec2 relVel = a_cState.velocity - b_cState.velocity;
-
-    // Velocity along the normal
-    const float velAlongNormal = glm::dot(relVel, info.normal);
-
-    // If separating and no penetration, skip
-    if (velAlongNormal > Config::physicsEpsilon && info.depth <= Config::physicsEpsilon) {
-        return;
-    }
-
-    // Restitution (elasticity)
-    const float e = std::clamp(std::min(a_Setup.elasticity, b_Setup.elasticity), 0.0f, 1.0f);
-
-    // Inverse masses
-    const float invMassA = a_Setup.isNotFixed ? 1.0f / a_Setup.mass : 0.0f;
-    const float invMassB = b_Setup.isNotFixed ? 1.0f / b_Setup.mass : 0.0f;
-
-    const float denom = epsiloned(invMassA + invMassB);
-    if (denom == 0.f) {
-        return; // both infinite mass
-    }
-
-    // Impulse scalar (normal)
-    const float j = -(1.0f + e) * velAlongNormal * 0.95f / denom;
-
-    const glm::vec2 impulse = j * info.normal;
-
-    /*
-        a b choice
-        0 0 1+2 = 3 // Don't care.
-        0 1 1+4 = 5
-        1 0 2+2 = 4
-        1 1 2+4 = 6
-    */
-    switch ((1 << a_Setup.canCollide) + (2 << b_Setup.canCollide)) {
-    case 4: {
-        const auto v = epsiloned(impulse * invMassA);
-
-        a_cState.velocity += v;
-        a_cState.position -= info.normal * info.depth;
-        break;
-    }
-    case 5: {
-        const auto v = epsiloned(impulse * invMassB);
-
-        b_cState.velocity -= v;
-        b_cState.position += info.normal * info.depth;
-        break;
-    }
-    case 6: {
-        a_cState.velocity += epsiloned(impulse * invMassA);
-        b_cState.velocity -= epsiloned(impulse * invMassB);
-        break;
-    }
-    case 3: {
-        break;
-    }
-    default: {
-        assert(false && "Entering this switch case should never have happened.");
-        break;
-    }
-    }
-}
-
 class CollisionReset
 {
 public:
@@ -182,9 +163,14 @@ public:
                Entity::PhysicsAngularState &aState,
                Entity::PhysicsSetup &setup,
                Entity::PhysicsForces &forces,
-               Entity::PhysicsConstraints &constraints) const
+               Entity::PhysicsConstraints &constraints,
+               Entity::PhysicsObjectState &objState) const
     {
-        Physics::compute(timeDelta, ReferencesSet{cState, aState, setup, forces, constraints});
+        if (!objState.simulated()) {
+            return;
+        }
+
+        Physics::compute(timeDelta * objState.lodSteps, ReferencesSet{cState, aState, setup, forces, constraints});
     }
 
     double timeDelta;
@@ -192,8 +178,6 @@ public:
 
 void Engine::compute()
 {
-    CTRACK;
-
     const auto currentTime = std::chrono::system_clock::now();
     const auto delta = static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - prevChrono).count()) / 400.0; // 200.0
 
@@ -202,31 +186,146 @@ void Engine::compute()
 		return;
 	}
 
+    step(delta);
+
+    prevChrono = currentTime;
+}
+
+void Engine::step(const double timeDelta)
+{
+    CTRACK;
+
+    const auto stepStart = std::chrono::steady_clock::now();
+    m_stats = Stats{.entities = m_scene->entities.size()};
+    ++m_ticks;
+
     /* Resolve collisions */ {
+        // Keep the last contacts around to tell which ones begin, stay or end.
+        m_scene->previousCollisions.swap(m_scene->collisions);
         m_scene->collisions.clear();
+        const auto allocations = m_scene->collisions.allocations();
         m_scene->entities.visit(CollisionReset());
-        resolveAllCollisions();
+
+        updateLevelOfDetail();
+
+        // Entities pushed since the last step must take part in it.
+        const auto forces = m_scene->dynamicColumn<Entity::PhysicsForces>();
+        for (size_t i = 0; i < forces.size(); ++i) {
+            if (!forces[i].empty()) {
+                wake(static_cast<int>(i));
+            }
+        }
+
+        updateWorldBounds();
+        m_trace.beginStep();
+        resolveAllCollisions(timeDelta);
+        m_trace.endStep();
+        m_stats.pairCacheAllocations = m_scene->collisions.allocations() - allocations;
+        emitContactEvents();
+
+        updateSleep();
     }
 
     /* Position update */ {
-        ObjectCompute computeVisitor(delta);
+        // Starting positions of the continuous entities, their motion is swept once integrated.
+        m_sweepStarts.clear();
+        const auto setups = m_scene->dynamicColumn<Entity::PhysicsSetup>();
+        const auto cStates = m_scene->dynamicColumn<Entity::PhysicsCartesianState>();
+        for (size_t i = 0; i < setups.size(); ++i) {
+            if (setups[i].continuous && setups[i].canCollide) {
+                m_sweepStarts.emplace_back(static_cast<int>(i), cStates[i].position);
+            }
+        }
+
+        const auto integrationStart = std::chrono::steady_clock::now();
+#ifdef JP_PHYSICS_RK4
+        ObjectCompute computeVisitor(timeDelta);
         m_scene->entities.visit(computeVisitor);
+#else
+        m_integrator.integrate(m_scene->entities, m_scene->dynamicCount, timeDelta);
+#endif
+        m_stats.integrationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - integrationStart).count();
+
+        sweepContinuous();
         updateMainPosition();
     }
 
-    prevChrono = currentTime;
+    m_stats.tickMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - stepStart).count();
 }
 
-void Engine::collisionResolutionFilter(const int a, const int b)
+void Engine::sweepContinuous()
 {
-    if (a == b) {
-        return;
+    CTRACK;
+
+    const auto &tree = m_scene->staticTree;
+    const auto cStates = m_scene->dynamicColumn<Entity::PhysicsCartesianState>();
+    const auto boxes = m_scene->dynamicColumn<Entity::AABB>();
+    const auto world = m_scene->entities.column<Entity::WorldAABB>();
+    const auto layers = m_scene->entities.column<Entity::CollisionLayers>();
+
+    for (const auto &[i, start] : m_sweepStarts) {
+        auto &cState = cStates[i];
+        const auto displacement = cState.position - start;
+
+        // Slow entities cannot skip over anything, the narrow phase is enough.
+        if (!needsSweep(boxes[i], displacement)) {
+            continue;
+        }
+        ++m_stats.sweptBodies;
+
+        const auto from = Entity::AABB{.min = start + boxes[i].min, .max = start + boxes[i].max};
+        const auto swept = Entity::AABB{
+            .min = glm::min(from.min, from.min + displacement),
+            .max = glm::max(from.max, from.max + displacement),
+        };
+
+        float impact = 1.f;
+        glm::vec2 normal{};
+        tree.query(swept, [&](const int b) -> void {
+            if (!layers[i].accepts(layers[b])) {
+                return;
+            }
+
+            glm::vec2 hitNormal{};
+            if (const float t = timeOfImpact(from, displacement, world[b].bounds, hitNormal); t < impact) {
+                impact = t;
+                normal = hitNormal;
+            }
+        });
+
+        if (impact >= 1.f) {
+            continue;
+        }
+        ++m_stats.sweptHits;
+
+        // Stop at the surface and drop the velocity going through it, the narrow phase takes over at the next step.
+        cState.position = start + displacement * (impact * Config::ccdBackoff);
+        cState.velocity -= std::min(glm::dot(cState.velocity, normal), 0.f) * normal;
+    }
+}
+
+void Engine::updateWorldBounds()
+{
+    CTRACK;
+
+    // The loader computed the bounds of the fixed entities.
+    const auto cStates = m_scene->dynamicColumn<Entity::PhysicsCartesianState>();
+    const auto boxes = m_scene->dynamicColumn<Entity::AABB>();
+    const auto world = m_scene->dynamicColumn<Entity::WorldAABB>();
+
+    for (size_t i = 0; i < world.size(); ++i) {
+        world[i].bounds = worldBounds(cStates[i], boxes[i]);
     }
+}
 
-    const std::pair m = {std::min(a, b), std::max(a, b)};
-    if (m_scene->collisions.contains(m)) {
+void Engine::collisionResolutionFilter(int a, int b, Batch &batch) const
+{
+    if (a == b) {
         return;
     }
+    if (a > b) {
+        std::swap(a, b);
+    }
 
     const auto argsA = m_scene->entities.at<removeConstReferencesType<Physics::ComputeState::CollisionParameters>>(a);
     const auto argsB = m_scene->entities.at<removeConstReferencesType<Physics::ComputeState::CollisionParameters>>(b);
@@ -235,54 +334,666 @@ void Engine::collisionResolutionFilter(const int a, const int b)
     const auto &bSetup = std::get<0>(argsB);
 
     const bool mayCollide = aSetup.canCollide || bSetup.canCollide;
-    const bool mayNotBeFixed = aSetup.isNotFixed || bSetup.isNotFixed;
+    // Sleeping entities are only tested against awake ones.
+    const bool mayMove = (aSetup.isNotFixed && std::get<1>(argsA).simulated()) || (bSetup.isNotFixed && std::get<1>(argsB).simulated());
+
+    auto &stats = batch.stats;
+
+    if (!(mayCollide && mayMove)) {
+        ++stats.filterRejected;
+        return;
+    }
 
-    if (!(mayCollide && mayNotBeFixed)) {
+    // Only the brute force broad phase lets pairs of incompatible layers through.
+    if (!m_scene->entities.at<Entity::CollisionLayers>(a).accepts(m_scene->entities.at<Entity::CollisionLayers>(b))) {
+        ++stats.layerRejected;
+        return;
+    }
+
+    // Cheap rejection before setting up the SAT test.
+    if (!m_scene->entities.at<Entity::WorldAABB>(a).bounds.intersects(m_scene->entities.at<Entity::WorldAABB>(b).bounds)) {
+        ++stats.aabbRejected;
         return;
     }
 
     // We need to resolve the collision.
 
-    if (Entity::CollisionInfo info{}; computeState.collides(argsA, argsB, info)) {
-        //std::cout << "Detected collision between entities " << e.id << " and " << e2.id << " normal=(" << info.normal.x << "," << info.normal.y << ") depth=" << info.depth << "\n";
-        resolveCollision(a, b, info);
+    const auto key = pairKey(a, b);
+    ++stats.axisCacheLookups;
+
+    // Pairs separated during the last step are most likely still separated by the same axis.
+    if (const auto *axis = m_axisCache.find(key); axis != nullptr) {
+        ++stats.satAxesTested;
+        const TraceScope cachedTrace{.trace = &m_trace, .tick = m_ticks, .a = a, .b = b, .kernel = TraceRecord::noKernel, .cached = 1};
+        if (computeState.separatedBy(m_scene->shapes, argsA, argsB, *axis, m_trace.enabled() ? &cachedTrace : nullptr)) {
+            ++stats.axisCacheHits;
+            ++stats.satRejected;
+            batch.separations.emplace_back(key, *axis);
+            return;
+        }
+    }
+
+    const TraceScope trace{.trace = &m_trace, .tick = m_ticks, .a = a, .b = b};
+
+    SeparatingAxis separating{};
+    if (Entity::CollisionInfo info{};
+        !computeState.collides(m_scene->shapes, argsA, argsB, info, separating, stats, m_trace.enabled() ? &trace : nullptr)) {
+        ++stats.satRejected;
+        batch.separations.emplace_back(key, separating);
+    } else {
+        batch.contacts.push_back(Contact{.a = a, .b = b, .info = info});
+    }
+}
+
+template<typename F>
+void Engine::detectInBatches(const size_t count, F &&detect)
+{
+    auto &pool = ThreadPool::instance();
+
+    const size_t threads = m_narrowPhaseThreads == 0 ? pool.threadsCount() : std::min(m_narrowPhaseThreads, pool.threadsCount());
+    const size_t batches = std::clamp<size_t>(count / Config::narrowPhaseBatchSize, 1, std::max<size_t>(threads, 1));
+
+    m_batches.resize(batches);
+    for (auto &batch : m_batches) {
+        batch.contacts.clear();
+        batch.separations.clear();
+        batch.stats = Stats{};
+    }
+
+    if (batches == 1) {
+        detect(0, count, m_batches[0]);
+    } else {
+        const size_t batchSize = (count + batches - 1) / batches;
+
+        m_batchFutures.clear();
+        for (size_t k = 0; k < batches; ++k) {
+            const size_t begin = std::min(k * batchSize, count);
+            const size_t end = std::min(begin + batchSize, count);
+            m_batchFutures.push_back(
+                pool.enqueue([this, &detect, k, begin, end]() -> void { detect(begin, end, m_batches[k]); }));
+        }
+        for (auto &future : m_batchFutures) {
+            future.get();
+        }
+    }
+
+    m_stats.narrowPhaseThreads = batches;
+}
+
+void Engine::resolveContacts(const double timeDelta)
+{
+    CTRACK;
+
+    m_contacts.clear();
+    m_nextAxisCache.clear();
+    for (const auto &batch : m_batches) {
+        m_contacts.insert(m_contacts.end(), batch.contacts.begin(), batch.contacts.end());
+        for (const auto &[key, axis] : batch.separations) {
+            m_nextAxisCache.insertOrAssign(key, axis);
+        }
+
+        m_stats.filterRejected += batch.stats.filterRejected;
+        m_stats.layerRejected += batch.stats.layerRejected;
+        m_stats.aabbRejected += batch.stats.aabbRejected;
+        m_stats.satRejected += batch.stats.satRejected;
+        m_stats.satAxesTested += batch.stats.satAxesTested;
+        m_stats.axisCacheLookups += batch.stats.axisCacheLookups;
+        m_stats.axisCacheHits += batch.stats.axisCacheHits;
+        for (size_t k = 0; k < m_stats.kernelPairs.size(); ++k) {
+            m_stats.kernelPairs[k] += batch.stats.kernelPairs[k];
+        }
+    }
+    m_axisCache.swap(m_nextAxisCache);
+
+    // The batches do not depend on the threads count, but their order does not matter anymore once sorted.
+    std::ranges::sort(m_contacts, {}, [](const Contact &contact) -> uint64_t { return pairKey(contact.a, contact.b); });
+
+    m_solver.begin();
+
+    for (const auto &contact : m_contacts) {
+        // A pair may be emitted twice by the broad phase.
+        if (!m_scene->collisions.insert(pairKey(contact.a, contact.b))) {
+            continue;
+        }
+
+        wake(contact.a);
+        wake(contact.b);
+
+        if (contact.info.depth >= Config::physicsEpsilon) {
+            m_solver.add(contact.a, contact.b, contact.info);
+        }
+
+        m_scene->entities.at<Entity::PhysicsObjectState>(contact.a).hasCollision = m_scene->entities.at<Entity::PhysicsSetup>(contact.a).canCollide;
+        m_scene->entities.at<Entity::PhysicsObjectState>(contact.b).hasCollision = m_scene->entities.at<Entity::PhysicsSetup>(contact.b).canCollide;
+
+        ++m_stats.collidingPairs;
+    }
+
+    // Pairs without any awake entity were not tested, their contacts still hold.
+    const auto setups = m_scene->entities.column<Entity::PhysicsSetup>();
+    const auto objStates = m_scene->entities.column<Entity::PhysicsObjectState>();
+    const auto resting = [&setups, &objStates](const int i) -> bool { return !setups[i].isNotFixed || !objStates[i].simulated(); };
+
+    for (const auto key : m_scene->previousCollisions.keys()) {
+        const int a = pairFirst(key);
+        const int b = pairSecond(key);
+        if (resting(a) && resting(b) && m_scene->collisions.insert(key)) {
+            objStates[a].hasCollision = setups[a].canCollide;
+            objStates[b].hasCollision = setups[b].canCollide;
+        }
+    }
 
-        std::get<1>(argsA).hasCollision = aSetup.canCollide;
-        std::get<1>(argsB).hasCollision = bSetup.canCollide;
+    /* Solve */ {
+        const auto solverStart = std::chrono::steady_clock::now();
+        m_solver.solve(m_scene->entities, timeDelta);
+        m_stats.solverMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - solverStart).count();
 
-        m_scene->collisions.insert(m);
+        m_stats.warmStartedContacts = m_solver.warmStarted();
+        for (const auto &manifold : m_solver.manifolds()) {
+            m_stats.maxPenetration = std::max(m_stats.maxPenetration, manifold.depth);
+        }
     }
 }
 
-void Engine::resolveAllCollisions()
+void Engine::emitContactEvents()
 {
-    const auto size = static_cast<int64_t>(m_scene->entities.size());
+    CTRACK;
+
+    if (!m_contactEvents.subscribed()) {
+        return;
+    }
 
-    for (int i = 0; i < size; i++) {
-        // For every entity in the current chunk, we check the entities in the current AND next chunk.
-        // Previous chunks' entities have already been checked against.
-        for (int j = i + 1; j < size; j++) {
-            collisionResolutionFilter(i, j);
+    const auto dropped = m_contactEvents.dropped();
+    const auto manifolds = m_solver.manifolds();
+    const auto push = [this](const ContactEvent &event) -> void {
+        m_contactEvents.push(event);
+        ++m_stats.contactEvents;
+    };
+
+    // Contacts and manifolds are both sorted by pair, the impulse of each contact is found in one pass.
+    size_t m = 0;
+    uint64_t previousKey = std::numeric_limits<uint64_t>::max();
+    for (const auto &contact : m_contacts) {
+        const auto key = pairKey(contact.a, contact.b);
+        // A pair may be emitted twice by the broad phase.
+        if (key == previousKey) {
+            continue;
+        }
+        previousKey = key;
+
+        while (m < manifolds.size() && pairKey(manifolds[m].a, manifolds[m].b) < key) {
+            ++m;
+        }
+        const bool solved = m < manifolds.size() && pairKey(manifolds[m].a, manifolds[m].b) == key;
+
+        push(ContactEvent{
+            .a = contact.a,
+            .b = contact.b,
+            .normal = contact.info.normal,
+            .depth = contact.info.depth,
+            .impulse = solved ? manifolds[m].normalImpulse : 0.f,
+            .kind = m_scene->previousCollisions.contains(key) ? ContactState::Stay : ContactState::Begin,
+        });
+    }
+
+    // Contacts carried over by resting pairs were not tested, and ended contacts have no contact data left.
+    const auto tested = [this](const uint64_t key) -> bool {
+        return std::ranges::binary_search(m_contacts, key, {}, [](const Contact &contact) -> uint64_t { return pairKey(contact.a, contact.b); });
+    };
+    for (const auto key : m_scene->previousCollisions.keys()) {
+        if (!m_scene->collisions.contains(key)) {
+            push(ContactEvent{.a = pairFirst(key), .b = pairSecond(key), .kind = ContactState::End});
+        } else if (!tested(key)) {
+            push(ContactEvent{.a = pairFirst(key), .b = pairSecond(key), .kind = ContactState::Stay});
         }
     }
+
+    m_stats.contactEventsDropped = m_contactEvents.dropped() - dropped;
+}
+
+void Engine::wake(const int i)
+{
+    auto &objState = m_scene->entities.at<Entity::PhysicsObjectState>(i);
+    if (objState.asleep) {
+        objState.asleep = false;
+        objState.calmTicks = 0;
+    }
+}
+
+void Engine::applyForce(const int i, const glm::vec2 force)
+{
+    m_scene->entities.at<Entity::PhysicsForces>(i).add(force);
+}
+
+void Engine::applyForce(const int i, const Entity::Thrust &thrust)
+{
+    auto [cState, bBox, forces] = m_scene->entities.at<Entity::PhysicsCartesianState, Entity::AABB, Entity::PhysicsForces>(i);
+    forces.add(thrust, center(cState, bBox));
+}
+
+void Engine::applyTorque(const int i, const float torque)
+{
+    m_scene->entities.at<Entity::PhysicsForces>(i).add(torque);
+}
+
+void Engine::updateLevelOfDetail()
+{
+    CTRACK;
+
+    const auto objStates = m_scene->dynamicColumn<Entity::PhysicsObjectState>();
+    const auto cStates = m_scene->dynamicColumn<Entity::PhysicsCartesianState>();
+    if (objStates.empty()) {
+        return;
+    }
+
+    // The view follows the player, entity 0.
+    const auto center = cStates[0].position;
+
+    constexpr auto frozen = static_cast<uint8_t>(LodTier::Frozen);
+    constexpr std::array<float, frozen> limits{Config::lodNearDistance, Config::lodFarDistance};
+
+    for (size_t i = 0; i < objStates.size(); ++i) {
+        auto &objState = objStates[i];
+
+        uint8_t tier = static_cast<uint8_t>(LodTier::Near);
+        if (m_levelOfDetail) {
+            const float distance = glm::length(cStates[i].position - center);
+
+            // Farther tiers are only entered past the limit plus the hysteresis, nearer ones as soon as it is crossed.
+            tier = objState.lodTier;
+            while (tier < frozen && distance > limits[tier] + Config::lodHysteresis) {
+                ++tier;
+            }
+            while (tier > 0 && distance < limits[tier - 1]) {
+                --tier;
+            }
+        }
+        objState.lodTier = tier;
+        ++m_stats.lodBodies[tier];
+
+        // Far entities are spread over the interval, so that each step simulates the same share of them.
+        const bool simulated = tier == static_cast<uint8_t>(LodTier::Near)
+                               || (tier == static_cast<uint8_t>(LodTier::Far) && (m_ticks + i) % Config::lodFarInterval == 0);
+        if (simulated) {
+            objState.lodSteps = objState.lodPending + 1;
+            objState.lodPending = 0;
+        } else {
+            objState.lodSteps = 0;
+            // Frozen entities do not catch the time up once back in range.
+            if (tier == static_cast<uint8_t>(LodTier::Far)) {
+                ++objState.lodPending;
+            }
+            ++m_stats.lodSkippedBodies;
+        }
+    }
+}
+
+void Engine::updateSleep()
+{
+    CTRACK;
+
+    const auto setups = m_scene->dynamicColumn<Entity::PhysicsSetup>();
+    const auto objStates = m_scene->dynamicColumn<Entity::PhysicsObjectState>();
+    const auto cStates = m_scene->dynamicColumn<Entity::PhysicsCartesianState>();
+    const auto size = setups.size();
+
+    constexpr float threshold = Config::sleepVelocity * Config::sleepVelocity;
+
+    /* Rest detection */
+    for (size_t i = 0; i < size; ++i) {
+        auto &objState = objStates[i];
+        if (!setups[i].isNotFixed || !objState.simulated()) {
+            continue;
+        }
+
+        const auto &cState = cStates[i];
+        // Acceleration includes gravity, which the contacts of a resting entity cancel, only its velocity tells.
+        const bool calm = glm::dot(cState.velocity, cState.velocity) < threshold;
+        objState.calmTicks = calm ? std::min<uint16_t>(objState.calmTicks + 1, Config::sleepTicks) : 0;
+    }
+
+    /* Islands */
+    m_islands.reset(size);
+    for (const auto key : m_scene->collisions.keys()) {
+        const int a = pairFirst(key);
+        const int b = pairSecond(key);
+        // Only moving entities are stored below dynamicCount.
+        if (b < static_cast<int>(size) && setups[a].isNotFixed && setups[b].isNotFixed) {
+            m_islands.link(a, b);
+        }
+    }
+
+    // An island sleeps once all its entities are at rest, and wakes up as soon as one of them is not.
+    m_islandAwake.assign(size, 0);
+    for (size_t i = 0; i < size; ++i) {
+        if (setups[i].isNotFixed && !objStates[i].asleep && objStates[i].calmTicks < Config::sleepTicks) {
+            m_islandAwake[m_islands.find(static_cast<int>(i))] = 1;
+        }
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        if (!setups[i].isNotFixed) {
+            continue;
+        }
+
+        auto &objState = objStates[i];
+        if (m_islandAwake[m_islands.find(static_cast<int>(i))]) {
+            wake(static_cast<int>(i));
+            ++m_stats.awakeBodies;
+        } else {
+            if (!objState.asleep) {
+                objState.asleep = true;
+                cStates[i].velocity = {};
+                cStates[i].acceleration = {};
+            }
+            ++m_stats.sleepingBodies;
+        }
+    }
+}
+
+void Engine::resolveAllCollisions(const double timeDelta)
+{
+    if (m_broadPhase == BroadPhase::BruteForce) {
+        const auto size = static_cast<int64_t>(m_scene->entities.size());
+        m_stats.candidatePairs = static_cast<size_t>(size * (size - 1) / 2);
+
+        const auto narrowPhaseStart = std::chrono::steady_clock::now();
+        // Batches of rows, the pairs are not stored.
+        detectInBatches(static_cast<size_t>(size), [this, size](const size_t begin, const size_t end, Batch &batch) -> void {
+            for (auto i = static_cast<int>(begin); i < static_cast<int>(end); i++) {
+                for (int j = i + 1; j < size; j++) {
+                    collisionResolutionFilter(i, j, batch);
+                }
+            }
+        });
+        resolveContacts(timeDelta);
+        m_stats.narrowPhaseMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - narrowPhaseStart).count();
+
+        return;
+    }
+
+    const std::vector<std::pair<int, int>> *pairs = nullptr;
+
+    /* Broad phase */ {
+        const auto broadPhaseStart = std::chrono::steady_clock::now();
+
+        if (m_broadPhase == BroadPhase::StaticTree) {
+            collectStaticTreePairs();
+            pairs = &m_treePairs;
+        } else if (m_broadPhase == BroadPhase::SpatialGrid) {
+            m_spatialGrid.update(m_scene->entities);
+            pairs = &m_spatialGrid.pairs();
+        } else {
+            m_sweepAndPrune.update(m_scene->entities);
+            pairs = &m_sweepAndPrune.pairs();
+        }
+
+        m_stats.broadPhaseMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - broadPhaseStart).count();
+    }
+
+    // Only the pairs whose world AABBs overlap may collide.
+    m_stats.candidatePairs = pairs->size();
+
+    const auto narrowPhaseStart = std::chrono::steady_clock::now();
+    detectInBatches(pairs->size(), [this, pairs](const size_t begin, const size_t end, Batch &batch) -> void {
+        for (size_t i = begin; i < end; ++i) {
+            collisionResolutionFilter((*pairs)[i].first, (*pairs)[i].second, batch);
+        }
+    });
+    resolveContacts(timeDelta);
+    m_stats.narrowPhaseMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - narrowPhaseStart).count();
+}
+
+void Engine::collectStaticTreePairs()
+{
+    CTRACK;
+
+    const auto &tree = m_scene->staticTree;
+
+    // The tree is built by the loader, rebuild it if entities were added since.
+    if (tree.builtFor() != m_scene->entities.size()) {
+        m_scene->staticTree.build(m_scene->entities);
+    }
+
+    m_treePairs.clear();
+
+    // Moving entities are stored first, fixed ones only exist in the tree.
+    const auto world = m_scene->dynamicColumn<Entity::WorldAABB>();
+    const auto objStates = m_scene->dynamicColumn<Entity::PhysicsObjectState>();
+    const auto layers = m_scene->entities.column<Entity::CollisionLayers>();
+
+    const auto size = static_cast<int>(world.size());
+    for (int a = 0; a < size; ++a) {
+        const auto &aBounds = world[a].bounds;
+
+        // Sleeping entities, and the ones skipped by the level of detail, are not tested against fixed ones.
+        if (objStates[a].simulated()) {
+            tree.query(aBounds, [this, a, &layers](const int b) -> void {
+                if (layers[a].accepts(layers[b])) {
+                    m_treePairs.emplace_back(std::min(a, b), std::max(a, b));
+                }
+            });
+        }
+
+        // There are only a few moving entities, test them against each other directly.
+        for (int b = a + 1; b < size; ++b) {
+            if (layers[a].accepts(layers[b]) && aBounds.intersects(world[b].bounds)) {
+                m_treePairs.emplace_back(a, b);
+            }
+        }
+    }
+}
+
+void Engine::publish(const float alpha)
+{
+    // Fixed entities never move, only the positions of the moving ones are published.
+    const auto cStates = m_scene->dynamicColumn<Entity::PhysicsCartesianState>();
+    const bool interpolate = m_previousPositions.size() == cStates.size();
+    auto &snapshot = m_scene->snapshots.back();
+    // Sized by the loader, this only allocates for scenes built otherwise.
+    snapshot.positions.resize(cStates.size());
+    snapshot.previous.resize(cStates.size());
+
+    for (size_t i = 0; i < cStates.size(); ++i) {
+        snapshot.positions[i] = cStates[i].position;
+        snapshot.previous[i] = interpolate ? m_previousPositions[i] : cStates[i].position;
+    }
+    snapshot.alpha = alpha;
+
+    m_scene->snapshots.publish();
 }
 
 void Engine::run(std::atomic<uint64_t> &commands)
 {
+    if constexpr (Config::fixedTimestep) {
+        runFixed(commands);
+    } else {
+        while (!(commands & Stop)) {
+            compute();
+            publish(1.f);
+        }
+    }
+
+    if (!m_tracePath.empty() && !saveCollisionTrace(m_tracePath)) {
+        std::cerr << "Could not write the collision trace to " << m_tracePath << '\n';
+    }
+}
+
+auto Engine::saveCollisionTrace(const std::string &path) const -> bool
+{
+    return m_trace.enabled() && m_trace.save(path);
+}
+
+void Engine::runFixed(std::atomic<uint64_t> &commands)
+{
+    using clock = std::chrono::steady_clock;
+
+    // One tick lasts 1/simTick of real time, and simulates simMultiplier steps of timestep().
+    constexpr auto tickPeriod = std::chrono::duration<double>(1.0 / Config::simTick);
+
+    if (m_previousTime == clock::time_point{}) {
+        m_previousTime = clock::now();
+    }
+
     while (!(commands & Stop)) {
-        compute();
+        const auto now = clock::now();
+        m_accumulator += now - m_previousTime;
+        m_previousTime = now;
+
+        // Do not try to catch up a long stall (loading, debugger...), it would stall again.
+        m_accumulator = std::min(m_accumulator, std::chrono::duration<double>(tickPeriod * Config::maxSimTicksCatchUp));
+
+        bool ticked = false;
+        while (m_accumulator >= tickPeriod) {
+            /* Keep the positions before the tick for interpolation */ {
+                const auto cStates = m_scene->dynamicColumn<Entity::PhysicsCartesianState>();
+                m_previousPositions.resize(cStates.size());
+                std::ranges::transform(cStates, m_previousPositions.begin(), &Entity::PhysicsCartesianState::position);
+            }
+
+            for (int i = 0; i < Config::simMultiplier; ++i) {
+                step(timestep());
+            }
+
+            m_accumulator -= tickPeriod;
+            ticked = true;
+        }
+
+        // Positions only change with a tick, the renderer blends them with its own frame time in between.
+        if (ticked) {
+            const auto alpha = static_cast<float>(m_accumulator / tickPeriod);
+            m_interpolationAlpha.store(alpha, std::memory_order_relaxed);
+            publish(alpha);
+        }
+
+        // Nothing to simulate nor publish before the next tick, sleep until then.
+        const auto nextTick = m_previousTime + std::chrono::duration_cast<clock::duration>(tickPeriod - m_accumulator);
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+template<typename F>
+void Engine::forEachOverlap(const Entity::AABB &bounds, const uint32_t mask, F &&fn) const
+{
+    const auto &entities = m_scene->entities;
+    const auto layers = entities.column<Entity::CollisionLayers>();
+    const auto cStates = entities.column<Entity::PhysicsCartesianState>();
+    const auto boxes = entities.column<Entity::AABB>();
+
+    m_scene->staticTree.query(bounds, [&](const int i) -> void {
+        if ((layers[i].category & mask) != 0) {
+            fn(i);
+        }
+    });
+
+    // Queries may run between two steps, the world bounds of the moving entities are not up to date then.
+    for (size_t i = 0; i < m_scene->dynamicCount; ++i) {
+        if ((layers[i].category & mask) != 0 && worldBounds(cStates[i], boxes[i]).intersects(bounds)) {
+            fn(static_cast<int>(i));
+        }
+    }
+}
+
+auto Engine::raycast(const RayQuery &query, RayHit &hit) const -> bool
+{
+    CTRACK;
+
+    const auto &entities = m_scene->entities;
+    const auto layers = entities.column<Entity::CollisionLayers>();
+    const auto bounds = entities.column<Entity::PhysicsBounds>();
+    const auto cStates = entities.column<Entity::PhysicsCartesianState>();
+    const auto boxes = entities.column<Entity::AABB>();
+
+    hit = RayHit{};
 
-        if (commands & PrepareDrawing) {
-            const auto pStateRange = m_scene->entities.range<Entity::PhysicsCartesianState>();
-            for (auto &&[obj, entity] : std::views::zip(m_scene->objects, pStateRange)) {
-                obj.position = glm::vec4(std::get<0>(entity).position, 0.f, 1.f);
+    // Returns the fraction left to walk after testing entity i.
+    const auto test = [&](const int i, const float maxFraction) -> float {
+        if ((layers[i].category & query.mask) == 0) {
+            return maxFraction;
+        }
+
+        glm::vec2 normal{};
+        float fraction = std::numeric_limits<float>::max();
+        for (uint32_t k = 0; k < m_scene->shapes.partCount(bounds[i].shape); ++k) {
+            const auto borders = m_scene->shapes.part(bounds[i].shape, k).borders;
+            glm::vec2 partNormal{};
+            if (const float partFraction = rayPolygon(query.origin, query.delta, cStates[i].position, borders, bounds[i].scale, maxFraction, partNormal);
+                partFraction < fraction) {
+                fraction = partFraction;
+                normal = partNormal;
             }
+        }
+        if (fraction > maxFraction) {
+            return maxFraction;
+        }
+
+        hit = RayHit{.entity = i, .fraction = fraction, .point = query.origin + query.delta * fraction, .normal = normal};
+        return fraction;
+    };
 
-            // Update states.
-            commands &= ~PrepareDrawing;
-            commands |= DrawingPrepared;
+    m_scene->staticTree.raycast(query.origin, query.delta, 1.f, test);
+
+    float maxFraction = hit.fraction;
+    for (size_t i = 0; i < m_scene->dynamicCount; ++i) {
+        if (rayAABB(query.origin, query.delta, worldBounds(cStates[i], boxes[i]), maxFraction) <= maxFraction) {
+            maxFraction = test(static_cast<int>(i), maxFraction);
         }
     }
+
+    return hit.entity >= 0;
+}
+
+auto Engine::raycast(const std::span<const RayQuery> queries, const std::span<RayHit> hits) const -> size_t
+{
+    CTRACK;
+
+    size_t count = 0;
+    const auto size = std::min(queries.size(), hits.size());
+    for (size_t i = 0; i < size; ++i) {
+        count += raycast(queries[i], hits[i]) ? 1 : 0;
+    }
+
+    return count;
+}
+
+auto Engine::overlapAABB(const Entity::AABB &bounds, const std::span<int> entities, const uint32_t mask) const -> size_t
+{
+    CTRACK;
+
+    size_t count = 0;
+    forEachOverlap(bounds, mask, [&](const int i) -> void {
+        if (count < entities.size()) {
+            entities[count] = i;
+        }
+        ++count;
+    });
+
+    return count;
+}
+
+auto Engine::overlapPoint(const glm::vec2 point, const std::span<int> entities, const uint32_t mask) const -> size_t
+{
+    CTRACK;
+
+    const auto bounds = m_scene->entities.column<Entity::PhysicsBounds>();
+    const auto cStates = m_scene->entities.column<Entity::PhysicsCartesianState>();
+
+    size_t count = 0;
+    forEachOverlap(Entity::AABB{.min = point, .max = point}, mask, [&](const int i) -> void {
+        const auto &shapes = m_scene->shapes;
+        const auto parts = std::views::iota(0u, shapes.partCount(bounds[i].shape));
+        if (std::ranges::none_of(parts, [&](const uint32_t k) -> bool {
+                return pointInPolygon(point, cStates[i].position, shapes.part(bounds[i].shape, k).borders, bounds[i].scale);
+            })) {
+            return;
+        }
+        if (count < entities.size()) {
+            entities[count] = i;
+        }
+        ++count;
+    });
+
+    return count;
 }
 
 void Engine::updateMainPosition()
@@ -294,19 +1005,21 @@ void Engine::updateMainPosition()
 
     if (m_inputState->left.unsafeGet().state) {
         std::cout << "left\n";
-        m_scene->entities.at<Entity::PhysicsForces>(0).thrusts.push_back(Entity::Thrust{.vector = {horVel, 0.f, 0.f}});
+        applyForce(0, glm::vec2{horVel, 0.f});
     }
     if (m_inputState->right.unsafeGet().state) {
         std::cout << "right\n";
-        m_scene->entities.at<Entity::PhysicsForces>(0).thrusts.push_back(Entity::Thrust{.vector = {-horVel, 0.f, 0.f}});
+        applyForce(0, glm::vec2{-horVel, 0.f});
     }
     if (m_inputState->down.unsafeGet().state) {
         std::cout << "down\n";
         m_scene->entities.at<Entity::PhysicsCartesianState>(0).velocity.x -= vertVel;
+        wake(0);
     }
     if (m_inputState->up.unsafeGet().state && !m_inputState->up.unsafeGet().hold) {
         std::cout << "up\n";
         m_scene->entities.at<Entity::PhysicsCartesianState>(0).velocity.x += vertVel;
+        wake(0);
     }
 }
 }
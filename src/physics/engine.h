@@ -2,7 +2,22 @@
 #define JP_PHYSICS_ENGINE_H
 
 #include <atomic>
+#include <chrono>
+#include <future>
 
+#include "src/config.h"
+#include "src/physics/contactevents.h"
+#include "src/physics/entity.h"
+#include "src/physics/enums.h"
+#include "src/physics/integrator.h"
+#include "src/physics/islands.h"
+#include "src/physics/pairmap.h"
+#include "src/physics/query.h"
+#include "src/physics/solver.h"
+#include "src/physics/spatialgrid.h"
+#include "src/physics/stats.h"
+#include "src/physics/sweepandprune.h"
+#include "src/physics/trace.h"
 #include "src/world/scene.h"
 
 namespace Input {
@@ -27,17 +42,162 @@ public:
     void setInputState(Input::InnerState &state);
     /// @brief Prepares per-frame transient simulation data.
     void prepare();
-    /// @brief Computes one simulation step.
+    /// @brief Computes one simulation step, using the wall-clock time elapsed since the previous one.
     void compute();
+    /// @brief Computes one simulation step of @param timeDelta.
+    void step(double timeDelta);
     /// @brief Runs simulation loop until stop command.
     void run(std::atomic<uint64_t> &commands);
 
+    /// @brief Selects the broad phase used from the next step on.
+    void setBroadPhase(BroadPhase broadPhase);
+    /// @brief Returns the broad phase currently in use.
+    _nodiscard auto broadPhase() const -> BroadPhase { return m_broadPhase; }
+    /// @brief Changes the cell size of the spatial grid broad phase.
+    void setGridCellSize(float cellSize);
+    /**
+     * @brief Sets the number of threads running the narrow phase, see Config::narrowPhaseThreads.
+     * The contacts are resolved in the same order whatever the count, results do not depend on it.
+     */
+    void setNarrowPhaseThreads(size_t threads) { m_narrowPhaseThreads = threads; }
+    /// @brief Returns the requested number of narrow phase threads, 0 meaning all of them.
+    _nodiscard auto narrowPhaseThreads() const -> size_t { return m_narrowPhaseThreads; }
+
+    /// @brief Sets the number of iterations of the contact solver, see Config::solverIterations.
+    void setSolverIterations(const int iterations) { m_solver.setIterations(iterations); }
+    /// @brief Returns the number of iterations of the contact solver.
+    _nodiscard auto solverIterations() const -> int { return m_solver.iterations(); }
+
+    /// @brief Enables the simulation level of detail, see Config::physicsLod.
+    void setLevelOfDetail(const bool enabled) { m_levelOfDetail = enabled; }
+    /// @brief Tells if the simulation level of detail is enabled.
+    _nodiscard auto levelOfDetail() const -> bool { return m_levelOfDetail; }
+
+    /// @brief Wakes entity @param i up, its island follows on the next step.
+    void wake(int i);
+    /// @brief Applies @param force at the center of entity @param i during the next step.
+    void applyForce(int i, glm::vec2 force);
+    /// @brief Applies @param thrust to entity @param i during the next step, at the thrust's point.
+    void applyForce(int i, const Entity::Thrust &thrust);
+    /// @brief Applies a torque of @param torque to entity @param i during the next step.
+    void applyTorque(int i, float torque);
+
+    /**
+     * @brief Share of the next fixed tick already accumulated when the last one ran, in [0, 1].
+     * Published with the positions of the tick, the renderer advances it with its own frame time to blend them;
+     * it is exposed for anything else that needs to interpolate (animations, camera...).
+     */
+    _nodiscard auto interpolationAlpha() const -> float { return m_interpolationAlpha.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Calls @param fn(a, b, state) for every contact that began, stayed or ended during the last step.
+     * @note a is always the lowest entity index of the pair.
+     */
+    template<typename F>
+    void forEachContact(F &&fn) const
+    {
+        const auto &current = m_scene->collisions;
+        const auto &previous = m_scene->previousCollisions;
+
+        for (const auto key : current.keys()) {
+            fn(pairFirst(key), pairSecond(key), previous.contains(key) ? ContactState::Stay : ContactState::Begin);
+        }
+        for (const auto key : previous.keys()) {
+            if (!current.contains(key)) {
+                fn(pairFirst(key), pairSecond(key), ContactState::End);
+            }
+        }
+    }
+
+    /**
+     * @brief Writes the axes recorded by the narrow phase to @param path, for tools/tracedump.
+     * The trace is enabled by the JUICE_COLLISION_TRACE environment variable, and saved to the file it names on exit.
+     * @return False when the trace is disabled or the file could not be written.
+     */
+    auto saveCollisionTrace(const std::string &path) const -> bool;
+
+    /**
+     * @brief Returns the contact events of every step, with their normal, depth and impulse.
+     * Pushed by the physics thread at the end of the collision resolution, to be drained by one other thread. Nothing is
+     * pushed until that thread subscribes, see ContactEventQueue::subscribe.
+     */
+    _nodiscard auto contactEvents() -> ContactEventQueue & { return m_contactEvents; }
+
+    /**
+     * @brief Finds the closest entity crossed by the segment of @param query, fills @param hit with it.
+     * @return false when nothing is hit, @param hit then has no entity.
+     */
+    auto raycast(const RayQuery &query, RayHit &hit) const -> bool;
+    /**
+     * @brief Casts every query of @param queries, @param hits receiving their results in the same order.
+     * @return Number of queries that hit an entity.
+     */
+    auto raycast(std::span<const RayQuery> queries, std::span<RayHit> hits) const -> size_t;
+    /**
+     * @brief Writes to @param entities the entities whose world AABB overlaps @param bounds.
+     * @param mask Collision layers reported, compared with the entities' category.
+     * @return Number of entities found, may be larger than @param entities, only its size is written.
+     */
+    auto overlapAABB(const Entity::AABB &bounds, std::span<int> entities, uint32_t mask = ~uint32_t(0)) const -> size_t;
+    /**
+     * @brief Writes to @param entities the entities whose outline contains @param point.
+     * @return Number of entities found, may be larger than @param entities, only its size is written.
+     */
+    auto overlapPoint(glm::vec2 point, std::span<int> entities, uint32_t mask = ~uint32_t(0)) const -> size_t;
+
+    /// @brief Returns the counters of the last simulation step.
+    _nodiscard auto stats() const -> const Stats & { return m_stats; }
+
 protected:
-    /// @brief Resolves contact between two entities.
-    void resolveCollision(int a, int b, const Entity::CollisionInfo &info);
-    void collisionResolutionFilter(int a, int b);
-    /// @brief Resolves all currently detected collisions.
-    void resolveAllCollisions();
+    /// @brief Contact found by the narrow phase, resolved once every candidate pair was tested.
+    struct Contact
+    {
+        /// @brief Lowest entity index of the pair.
+        int a = 0;
+        /// @brief Highest entity index of the pair.
+        int b = 0;
+        /// @brief Normal, from a to b, and depth of the contact.
+        Entity::CollisionInfo info{};
+    };
+
+    /// @brief Output of a narrow phase batch, merged on the physics thread.
+    struct Batch
+    {
+        /// @brief Colliding pairs found by the batch.
+        std::vector<Contact> contacts{};
+        /// @brief Pairs separated by the SAT test, with their separating axis.
+        std::vector<std::pair<uint64_t, SeparatingAxis>> separations{};
+        /// @brief Rejection counters of the batch.
+        Stats stats{};
+    };
+
+    /**
+     * @brief Tests a candidate pair, records the result in @param batch.
+     * @note Does not modify the scene, it is called from the narrow phase workers.
+     */
+    void collisionResolutionFilter(int a, int b, Batch &batch) const;
+    /// @brief Detects and resolves the collisions of a step of @param timeDelta.
+    void resolveAllCollisions(double timeDelta);
+    /// @brief Splits @param count candidates in batches tested by @param detect, on the thread pool if allowed.
+    template<typename F>
+    void detectInBatches(size_t count, F &&detect);
+    /// @brief Gathers the contacts found by the batches, sorted by pair, and solves them over @param timeDelta.
+    void resolveContacts(double timeDelta);
+    /// @brief Pushes the contacts beginning, staying and ending this step to @var m_contactEvents.
+    void emitContactEvents();
+    /// @brief Sorts the moving entities in level of detail tiers by distance to the player, and tells which ones this step simulates.
+    void updateLevelOfDetail();
+    /// @brief Counts the steps moving entities spend at rest, puts resting islands to sleep and wakes the others.
+    void updateSleep();
+    /// @brief Calls @param fn with every entity whose world AABB overlaps @param bounds and belongs to @param mask.
+    template<typename F>
+    void forEachOverlap(const Entity::AABB &bounds, uint32_t mask, F &&fn) const;
+    /// @brief Stops continuous entities that moved through a fixed one during the integration at their time of impact.
+    void sweepContinuous();
+    /// @brief Refreshes the Entity::WorldAABB column from the positions.
+    void updateWorldBounds();
+    /// @brief Fills @var m_treePairs by querying the scene's static tree with every moving entity.
+    void collectStaticTreePairs();
 
 private:
     /// @brief Scene currently simulated.
@@ -45,6 +205,63 @@ private:
     /// @brief Borrowed input state pointer.
     Input::InnerState *m_inputState = nullptr;
 
+    /// @brief Broad phase producing the candidate pairs.
+    BroadPhase m_broadPhase = BroadPhase::StaticTree;
+    /// @brief Sweep-and-prune broad phase state.
+    SweepAndPrune m_sweepAndPrune{};
+    /// @brief Spatial grid broad phase state.
+    SpatialGrid m_spatialGrid{};
+    /// @brief Pairs found by the static tree broad phase.
+    std::vector<std::pair<int, int>> m_treePairs{};
+    /// @brief Simulates the entities far from the player less often, see Config::physicsLod.
+    bool m_levelOfDetail = Config::physicsLod;
+    /// @brief Requested number of narrow phase threads, 0 meaning all of them.
+    size_t m_narrowPhaseThreads = Config::narrowPhaseThreads;
+    /// @brief Output of the narrow phase batches.
+    std::vector<Batch> m_batches{};
+    /// @brief Pending narrow phase batches.
+    std::vector<std::future<void>> m_batchFutures{};
+    /// @brief Contacts of all the batches, in resolution order.
+    std::vector<Contact> m_contacts{};
+    /// @brief Axis that separated each pair during the last step, tested first by the narrow phase.
+    PairMap<SeparatingAxis> m_axisCache{};
+    /// @brief Axis cache being filled for the next step.
+    PairMap<SeparatingAxis> m_nextAxisCache{};
+    /// @brief Continuous entities and their position before the integration.
+    std::vector<std::pair<int, glm::vec2>> m_sweepStarts{};
+    /// @brief Contact solver, keeps the manifolds of the previous step.
+    Solver m_solver{};
+    /// @brief Islands of touching moving entities, rebuilt by @fn updateSleep.
+    Islands m_islands{};
+    /// @brief Per island root, tells if one of its entities is not at rest.
+    std::vector<uint8_t> m_islandAwake{};
+    /// @brief Batched integrator, unused when built with PHYSICS_RK4.
+    Integrator m_integrator{};
+    /// @brief Axes tested by the narrow phase, recorded from its const workers.
+    mutable CollisionTrace m_trace{};
+    /// @brief File @var m_trace is saved to when the simulation stops, empty when disabled.
+    std::string m_tracePath{};
+    /// @brief Steps simulated so far, tags the trace records.
+    uint32_t m_ticks = 0;
+    /// @brief Contact events ring, see @fn contactEvents.
+    ContactEventQueue m_contactEvents{};
+    /// @brief Counters of the last simulation step.
+    Stats m_stats{};
+
+    /// @brief Time of the last accumulator update of the fixed timestep loop.
+    std::chrono::steady_clock::time_point m_previousTime{};
+    /// @brief Simulated time not consumed by a tick yet.
+    std::chrono::duration<double> m_accumulator{};
+    /// @brief Entities positions at the beginning of the last fixed tick.
+    std::vector<glm::vec2> m_previousPositions{};
+    /// @brief Blending factor between @var m_previousPositions and the current positions when the last tick ran.
+    std::atomic<float> m_interpolationAlpha = 1.f;
+
+    /// @brief Fixed timestep loop, see Config::fixedTimestep.
+    void runFixed(std::atomic<uint64_t> &commands);
+    /// @brief Publishes the moving entities' positions before and after the last tick, with @param alpha, to the scene's snapshots.
+    void publish(float alpha);
+
     /// @brief Emits debug dump of simulation state.
     void dump() const;
 
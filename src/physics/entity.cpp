@@ -3,10 +3,7 @@
 #include <boost/numeric/odeint.hpp>
 
 #include "src/defines.h"
-#include "src/utils.h"
-
-
-constexpr double GRAVITY = -0.05;
+#include "src/physics/defines.h"
 
 namespace Physics
 {
@@ -20,7 +17,7 @@ void KingKutta(const state_type &y,
                const double gravity,
                const double mass,
                const bool isNotFixed,
-               const std::vector<Entity::Thrust> &thrusts,
+               const glm::vec2 force,
                const double kx,
                const double ky,
                const double kt)
@@ -32,11 +29,10 @@ void KingKutta(const state_type &y,
     //const auto &theta = y[2];
 
     if (isNotFixed) {
-        vx = (static_cast<double>(utils::accumulate<utils::Access<&Entity::Thrust::vector, &glm::vec3::x>>(thrusts, 0.f)) - kx * vx)
+        vx = (static_cast<double>(force.x) - kx * vx)
              / static_cast<double>(mass);
         // Because for us, Y is in the opposite direction, we have to invert the operation for the Weight & frictions.
-        vy = (static_cast<double>(utils::accumulate<utils::Access<&Entity::Thrust::vector, &glm::vec3::y>>(thrusts, 0.f))
-              + static_cast<double>(mass) * gravity - ky * vy)
+        vy = (static_cast<double>(force.y) + static_cast<double>(mass) * gravity - ky * vy)
              / static_cast<double>(mass);
     }
 
@@ -46,8 +42,7 @@ void KingKutta(const state_type &y,
 
     // dtheta/dt
     // [NOTE] We currently ignore the effect of vert & horiz friction on net torque.
-    /*dydt[2] = (static_cast<double>(utils::accumulate<utils::access<&Thrust::point>, utils::access<&Thrust::vector>, &utils::cross>(thrusts, 0.f))
-               + static_cast<double>(utils::accumulate(torques, 0.f)) - kt * theta)
+    /*dydt[2] = (static_cast<double>(torque) - kt * theta)
               / static_cast<double>(MoI);*/
 }
 
@@ -57,7 +52,7 @@ auto resultOfForces(const glm::vec2 velocity,
                     const float friction,
                     const double mass,
                     const bool isNotFixed,
-                    const std::vector<Entity::Thrust> &thrusts,
+                    const glm::vec2 force,
                     const double timeStep) -> Entity::Forces
 {
 	// [vx, vy, theta]
@@ -67,9 +62,9 @@ auto resultOfForces(const glm::vec2 velocity,
     boost::numeric::odeint::integrate_const(
         boost::numeric::odeint::runge_kutta4<state_type>(),
         // The system function
-        [friction, mass, isNotFixed, &thrusts](const state_type &yValue, state_type &dydtValue, const double t) -> auto {
+        [friction, mass, isNotFixed, force](const state_type &yValue, state_type &dydtValue, const double t) -> auto {
             unused(t);
-            return KingKutta(yValue, dydtValue, GRAVITY, mass, isNotFixed, thrusts, friction, friction, friction);
+            return KingKutta(yValue, dydtValue, gravity, mass, isNotFixed, force, friction, friction, friction);
         },
         y,              // Initial state
         0.0,            // Start time
@@ -94,7 +89,7 @@ void compute(const double timeDelta, ComputeParameters params)
                                                                pConstraints.friction,
                                                                pSetup.mass,
                                                                pSetup.isNotFixed,
-                                                               pForces.thrusts,
+                                                               pForces.force,
                                                                timeDelta);
         aState.angularVelocity = static_cast<float>(fAngularVelocity);
 
@@ -103,7 +98,7 @@ void compute(const double timeDelta, ComputeParameters params)
         cState.velocity = nextVelocity(cState, static_cast<float>(timeDelta));
         cState.position = nextPosition(cState, static_cast<float>(timeDelta));
 
-        pForces.thrusts.clear();
+        pForces.clear();
     }
 }
 }
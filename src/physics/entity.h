@@ -5,13 +5,19 @@
 #include <glm/fwd.hpp>
 #include <glm/geometric.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstdlib>
-#include <iostream>
 #include <span>
 #include <vector>
 
 #include "src/entity/components.h"
 #include "src/keywords.h"
+#include "src/physics/kernels.h"
+#include "src/physics/projection.h"
+#include "src/physics/shapepool.h"
+#include "src/physics/stats.h"
 
 namespace Physics
 {
@@ -42,6 +48,15 @@ _nodiscard constexpr auto center(const Entity::PhysicsCartesianState &state, con
     return state.position + (boundingBox.min + boundingBox.max) * 0.5f;
 }
 
+/// @brief Returns the bounding box translated to world space.
+_nodiscard constexpr auto worldBounds(const Entity::PhysicsCartesianState &state, const Entity::AABB &boundingBox) noexcept
+{
+    return Entity::AABB{
+        .min = state.position + boundingBox.min,
+        .max = state.position + boundingBox.max,
+    };
+}
+
 /// @brief Projects polygon borders onto an axis and returns min/max interval.
 _nodiscard constexpr auto getMinMax(const glm::vec2 &position, const std::span<const glm::vec2> &borders, const glm::vec2 &axis) noexcept
 {
@@ -78,7 +93,7 @@ _nodiscard auto resultOfForces(glm::vec2 velocity,
                                float friction,
                                double mass,
                                bool isNotFixed,
-                               const std::vector<Entity::Thrust> &thrusts,
+                               glm::vec2 force,
                                double timeStep) -> Entity::Forces;
 
 /// @brief Advances simulation state to next frame.
@@ -87,11 +102,6 @@ void compute(double timeDelta, ComputeParameters params);
 class ComputeState
 {
 public:
-    /// @brief Enables verbose collision logs through environment variable.
-    const bool debug = getenv("JUICE_DEBUG_COLLISIONS") != nullptr;
-
-    using DebugParameters
-        = ReferencesSet<const Entity::PhysicsObjectState, const Entity::PhysicsCartesianState, const Entity::AABB, const Entity::PhysicsBounds>;
     using CollisionParameters = ReferencesSet<const Entity::PhysicsSetup,
                                               const Entity::PhysicsObjectState,
                                               const Entity::PhysicsBounds,
@@ -101,107 +111,123 @@ public:
                                               const Entity::PhysicsCartesianState,
                                               const Entity::PhysicsAngularState>;
 
-    static void printDebugData(DebugParameters a, DebugParameters b)
+    /// @brief Returns true if @param axis separates the two entities, @see collides. Records the test in @param trace if any.
+    _nodiscard auto separatedBy(const ShapePool &shapes,
+                                CollisionParameters a,
+                                CollisionParameters b,
+                                const SeparatingAxis axis,
+                                const TraceScope *trace = nullptr) const noexcept
     {
-        auto &[a_objState, a_cState, a_boundingBox, a_bounds] = a;
-        auto &[b_objState, b_cState, b_boundingBox, b_bounds] = b;
+        const auto &a_bounds = std::get<2>(a);
+        const auto &b_bounds = std::get<2>(b);
+        const auto a_shape = shapes.shape(a_bounds.shape);
+        const auto b_shape = shapes.shape(b_bounds.shape);
+        const auto &owner = axis.owner == 0 ? a_bounds : b_bounds;
+        const auto normals = axis.owner == 0 ? a_shape.normals : b_shape.normals;
+
+        // Shapes may have changed since the axis was cached.
+        if (axis.index >= normals.size()) {
+            return false;
+        }
 
-        const auto aCenter = center(a_cState, a_boundingBox);
-        const auto bCenter = center(b_cState, b_boundingBox);
+        float aMin = 0.f;
+        float aMax = 0.f;
+        float bMin = 0.f;
+        float bMax = 0.f;
+        const std::array normal{scaledNormal(normals[axis.index], owner.scale)};
+        projectPolygon(a_shape.xs, a_shape.ys, std::get<6>(a).position, a_bounds.scale, normal, &aMin, &aMax);
+        projectPolygon(b_shape.xs, b_shape.ys, std::get<6>(b).position, b_bounds.scale, normal, &bMin, &bMax);
 
-        std::cout << "--- COLLISION CHECK: this id=" << a_objState.id << " other id=" << b_objState.id << "\n";
-        std::cout << "this pos=" << a_cState.position.x << "," << a_cState.position.y << " center=" << aCenter.x << "," << aCenter.y << "\n";
-        std::cout << "other pos=" << b_cState.position.x << "," << b_cState.position.y << " center=" << bCenter.x << "," << bCenter.y << "\n";
-        std::cout << "this borders count=" << a_bounds.borders.size() << " normals count=" << a_bounds.normals.size() << "\n";
-        std::cout << "other borders count=" << b_bounds.borders.size() << " normals count=" << b_bounds.normals.size() << "\n";
+        if (trace != nullptr) {
+            trace->axis(axis.index, axis.owner, normal[0].x, normal[0].y, aMin, aMax, bMin, bMax);
+        }
+
+        return aMax < bMin || bMax < aMin;
     }
 
-    /// @brief SAT collision test against another entity.
-    _nodiscard auto collides(CollisionParameters a, CollisionParameters b, ::Entity::CollisionInfo &info) const noexcept
+    /**
+     * @brief Narrow phase test against another entity.
+     * Each pair of convex parts is tested by the kernel of their kinds (@var pairKernels), compound shapes being
+     * tested part against part, the deepest contact being kept.
+     * @param shapes Pool holding the outlines of the entities.
+     * @param separating Receives the axis separating the entities, when they do not collide.
+     * @param stats Receives the number of axes tested and of kernels called.
+     * @param trace Receives the axes tested, unless null.
+     */
+    _nodiscard auto collides(const ShapePool &shapes,
+                             CollisionParameters a,
+                             CollisionParameters b,
+                             ::Entity::CollisionInfo &info,
+                             SeparatingAxis &separating,
+                             Stats &stats,
+                             const TraceScope *trace = nullptr) const noexcept -> bool
     {
         auto &[a_setup, a_objState, a_bounds, a_bBox, a_constraints, a_forces, a_cState, a_aState] = a;
         auto &[b_setup, b_objState, b_bounds, b_bBox, b_constraints, b_forces, b_cState, b_aState] = b;
 
-        // t: this, o: other, b: borders, n: normals
-        const auto tb = std::span(a_bounds.borders.data(), a_bounds.borders.size());
-        const auto tn = std::span(a_bounds.normals.data(), a_bounds.normals.size());
-        const auto ob = std::span(b_bounds.borders.data(), b_bounds.borders.size());
-        const auto on = std::span(b_bounds.normals.data(), b_bounds.normals.size());
-
-        float minOverlap = std::numeric_limits<float>::max();
-        glm::vec2 smallestAxis{};
-
-        if (debug) {
-            printDebugData({a_objState, a_cState, a_bBox, a_bounds}, {b_objState, b_cState, b_bBox, b_bounds});
+        // Single parts on both sides, dispatched directly.
+        if (shapes.kind(a_bounds.shape) != ShapeKind::Compound && shapes.kind(b_bounds.shape) != ShapeKind::Compound) {
+            const PlacedShape a_placed{.shape = shapes.shape(a_bounds.shape), .position = a_cState.position, .scale = a_bounds.scale};
+            const PlacedShape b_placed{.shape = shapes.shape(b_bounds.shape), .position = b_cState.position, .scale = b_bounds.scale};
+            return collidesParts(a_placed, b_placed, info, separating, stats, trace);
         }
 
-        for (const auto &normal : tn) {
-            const auto firstIntersect = getMinMax(a_cState.position, tb, normal);
-            const auto secondIntersect = getMinMax(b_cState.position, ob, normal);
-
-            // Check if it is separated.
-            if (firstIntersect.maxProj < secondIntersect.minProj || secondIntersect.maxProj < firstIntersect.minProj) {
-                if (debug) {
-                    std::cout << "Separated on this's axis: (" << normal.x << "," << normal.y << ")\n";
-                    std::cout << "  this proj: [" << firstIntersect.minProj << "," << firstIntersect.maxProj << "] other proj: ["
-                              << secondIntersect.minProj << "," << secondIntersect.maxProj << "]\n";
+        const auto a_whole = shapes.shape(a_bounds.shape);
+        const auto b_whole = shapes.shape(b_bounds.shape);
+        const auto a_parts = shapes.partCount(a_bounds.shape);
+        const auto b_parts = shapes.partCount(b_bounds.shape);
+
+        bool colliding = false;
+        bool separated = false;
+
+        for (uint32_t i = 0; i < a_parts; ++i) {
+            const PlacedShape a_part{.shape = shapes.part(a_bounds.shape, i), .position = a_cState.position, .scale = a_bounds.scale};
+
+            for (uint32_t j = 0; j < b_parts; ++j) {
+                const PlacedShape b_part{.shape = shapes.part(b_bounds.shape, j), .position = b_cState.position, .scale = b_bounds.scale};
+
+                ::Entity::CollisionInfo partInfo{};
+                SeparatingAxis partAxis{};
+                if (collidesParts(a_part, b_part, partInfo, partAxis, stats, trace)) {
+                    if (!colliding || partInfo.depth > info.depth) {
+                        info = partInfo;
+                    }
+                    colliding = true;
+                } else if (!separated) {
+                    // Cached axes index the normals of the whole shape.
+                    const auto &owner = partAxis.owner == 0 ? a_part.shape : b_part.shape;
+                    const auto &whole = partAxis.owner == 0 ? a_whole : b_whole;
+                    separating = SeparatingAxis{
+                        .index = static_cast<uint32_t>(owner.normals.data() - whole.normals.data()) + partAxis.index,
+                        .owner = partAxis.owner,
+                    };
+                    separated = true;
                 }
-
-                return false;
-            }
-
-            const float overlap = std::min(firstIntersect.maxProj - secondIntersect.minProj, secondIntersect.maxProj - firstIntersect.minProj);
-            if (debug) {
-                std::cout << "Axis (this): (" << normal.x << "," << normal.y << ") proj this=[" << firstIntersect.minProj << ","
-                          << firstIntersect.maxProj << "] other=[" << secondIntersect.minProj << "," << secondIntersect.maxProj
-                          << "] overlap=" << overlap << "\n";
-            }
-            if (overlap < minOverlap) {
-                minOverlap = overlap;
-                smallestAxis = normal;
             }
         }
 
-        for (const auto &normal : on) {
-            const auto firstIntersect = getMinMax(a_cState.position, tb, normal);
-            const auto secondIntersect = getMinMax(b_cState.position, ob, normal);
-
-            // Check if it is separated
-            if (firstIntersect.maxProj < secondIntersect.minProj || secondIntersect.maxProj < firstIntersect.minProj) {
-                if (debug) {
-                    std::cout << "Separated on other's axis: (" << normal.x << "," << normal.y << ")\n";
-                    std::cout << "  this proj: [" << firstIntersect.minProj << "," << firstIntersect.maxProj << "] other proj: ["
-                              << secondIntersect.minProj << "," << secondIntersect.maxProj << "]\n";
-                }
-
-                return false;
-            }
-
-            const float overlap = std::min(firstIntersect.maxProj - secondIntersect.minProj, secondIntersect.maxProj - firstIntersect.minProj);
-            if (debug) {
-                std::cout << "Axis (other): (" << normal.x << "," << normal.y << ") proj this=[" << firstIntersect.minProj << ","
-                          << firstIntersect.maxProj << "] other=[" << secondIntersect.minProj << "," << secondIntersect.maxProj
-                          << "] overlap=" << overlap << "\n";
-            }
-            if (overlap < minOverlap) {
-                minOverlap = overlap;
-                smallestAxis = normal;
-            }
-        }
+        return colliding;
+    }
 
-        // Ensure the normal points from this entity to the other entity.
-        // Use (other.center - center) so a negative dot indicates the axis
-        // points away from the other entity and must be inverted.
-        const auto aCenter = center(a_cState, a_bBox);
-        const auto bCenter = center(b_cState, b_bBox);
-        if (const auto centerDelta = bCenter - aCenter; glm::dot(centerDelta, smallestAxis) < 0.f) {
-            smallestAxis = -smallestAxis;
+    /// @brief Tests two convex parts with the kernel of their kinds, @see collides.
+    _nodiscard static auto collidesParts(const PlacedShape &a,
+                                         const PlacedShape &b,
+                                         ::Entity::CollisionInfo &info,
+                                         SeparatingAxis &separating,
+                                         Stats &stats,
+                                         const TraceScope *trace) noexcept -> bool
+    {
+        const auto index = pairKernelIndex(a.shape.kind, b.shape.kind);
+        ++stats.kernelPairs[index];
+        const auto kernel = pairKernels[static_cast<size_t>(a.shape.kind)][static_cast<size_t>(b.shape.kind)];
+
+        if (trace != nullptr) {
+            auto scope = *trace;
+            scope.kernel = static_cast<uint8_t>(index);
+            return kernel(a, b, info, separating, stats.satAxesTested, &scope);
         }
 
-        info.normal = glm::normalize(smallestAxis);
-        info.depth = minOverlap;
-
-        return true;
+        return kernel(a, b, info, separating, stats.satAxesTested, nullptr);
     }
 };
 
@@ -0,0 +1,70 @@
+#ifndef JP_PHYSICS_ENUMS_H
+#define JP_PHYSICS_ENUMS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Physics {
+
+/**
+ * @brief Broad phase algorithm used to generate the candidate pairs of the narrow phase.
+ */
+enum class BroadPhase : uint8_t {
+    BruteForce = 0, ///< Every pair of entities is tested, O(n²).
+    SweepAndPrune,  ///< Entities sorted along X, only overlapping intervals are paired.
+    SpatialGrid,    ///< Entities bucketed in a uniform hash grid, only entities sharing a cell are paired.
+    StaticTree,     ///< Moving entities query the scene's tree of fixed entities, and are tested against each other.
+
+    First = BruteForce,
+    Last = StaticTree,
+};
+
+/**
+ * @brief Lifetime stage of a contact between two entities, relative to the previous step.
+ */
+enum class ContactState : uint8_t {
+    Begin = 0, ///< The pair collides now but did not during the previous step.
+    Stay,      ///< The pair collided during both steps.
+    End,       ///< The pair collided during the previous step only.
+};
+
+/**
+ * @brief Simulation level of detail of a moving entity, by distance to the player.
+ */
+enum class LodTier : uint8_t {
+    Near = 0, ///< Simulated every step.
+    Far,      ///< Simulated every Config::lodFarInterval steps, with a time step as many times longer.
+    Frozen,   ///< Not simulated.
+
+    First = Near,
+    Last = Frozen,
+};
+
+/// @brief Number of level of detail tiers.
+inline constexpr size_t lodTierCount = static_cast<size_t>(LodTier::Last) + 1;
+
+/**
+ * @brief Behavior of the contact event ring when it is full, see Physics::ContactEventQueue.
+ */
+enum class ContactOverflow : uint8_t {
+    Drop = 0, ///< New events are dropped and counted, the simulation never waits.
+    Wait,     ///< The physics thread waits for the consumer, no event is lost.
+};
+
+/**
+ * @brief Kind of a collision shape, selecting the narrow phase kernel of a pair, see pairKernels.
+ * The first kinds are the convex ones, a compound shape is made of convex parts of these kinds.
+ */
+enum class ShapeKind : uint8_t {
+    Box = 0,     ///< Rectangle aligned on the world axes, its bounds.
+    OrientedBox, ///< Rotated rectangle, two axes.
+    Convex,      ///< Any convex polygon.
+    Compound,    ///< Several convex parts.
+};
+
+/// @brief Number of convex shape kinds, the kinds a pair kernel tests.
+inline constexpr size_t convexShapeKinds = static_cast<size_t>(ShapeKind::Compound);
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_ENUMS_H
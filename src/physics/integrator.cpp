@@ -0,0 +1,129 @@
+#include "src/physics/integrator.h"
+
+#include <ctrack.hpp>
+
+#include "src/physics/defines.h"
+
+namespace
+{
+
+/**
+ * @brief Integration kernel, kept free of branches and aliasing so it is auto-vectorized.
+ * Velocity is updated first, then moves the position (semi-implicit Euler), acceleration receives the change of velocity
+ * over the step.
+ */
+void integrateColumns(const size_t count,
+                      const float *__restrict dts,
+                      float *__restrict px,
+                      float *__restrict py,
+                      float *__restrict vx,
+                      float *__restrict vy,
+                      float *__restrict ax,
+                      float *__restrict ay,
+                      const float *__restrict fx,
+                      const float *__restrict fy,
+                      const float *__restrict invMass,
+                      const float *__restrict drag)
+{
+    constexpr auto g = static_cast<float>(Physics::gravity);
+
+    for (size_t i = 0; i < count; ++i) {
+        const float dt = dts[i];
+        const float damping = 1.f / (1.f + drag[i] * dt * invMass[i]);
+        const float ix = (vx[i] + fx[i] * invMass[i] * dt) * damping;
+        const float iy = (vy[i] + (fy[i] * invMass[i] + g) * dt) * damping;
+
+        ax[i] = (ix - vx[i]) / dt;
+        ay[i] = (iy - vy[i]) / dt;
+        vx[i] = ix;
+        vy[i] = iy;
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+    }
+}
+
+} // namespace
+
+namespace Physics
+{
+
+void Integrator::resize(const size_t count)
+{
+    m_px.resize(count);
+    m_py.resize(count);
+    m_vx.resize(count);
+    m_vy.resize(count);
+    m_ax.resize(count);
+    m_ay.resize(count);
+    m_fx.resize(count);
+    m_fy.resize(count);
+    m_invMass.resize(count);
+    m_drag.resize(count);
+    m_dt.resize(count);
+}
+
+void Integrator::integrate(Entities &entities, const size_t dynamicCount, const double timeDelta)
+{
+    CTRACK;
+
+    const auto setups = entities.column<Entity::PhysicsSetup>();
+    const auto constraints = entities.column<Entity::PhysicsConstraints>();
+    const auto cStates = entities.column<Entity::PhysicsCartesianState>();
+    const auto forces = entities.column<Entity::PhysicsForces>();
+    const auto objStates = entities.column<Entity::PhysicsObjectState>();
+
+    /* Gather */ {
+        m_indices.clear();
+        for (size_t i = 0; i < dynamicCount; ++i) {
+            if (setups[i].isNotFixed && objStates[i].simulated()) {
+                m_indices.push_back(static_cast<int>(i));
+            }
+        }
+
+        resize(m_indices.size());
+
+        for (size_t r = 0; r < m_indices.size(); ++r) {
+            const auto i = m_indices[r];
+            const auto &cState = cStates[i];
+
+            m_px[r] = cState.position.x;
+            m_py[r] = cState.position.y;
+            m_vx[r] = cState.velocity.x;
+            m_vy[r] = cState.velocity.y;
+            m_invMass[r] = 1.f / setups[i].mass;
+            m_drag[r] = constraints[i].friction;
+            // Entities far from the player catch the steps they skipped up.
+            m_dt[r] = static_cast<float>(timeDelta) * static_cast<float>(objStates[i].lodSteps);
+
+            m_fx[r] = forces[i].force.x;
+            m_fy[r] = forces[i].force.y;
+        }
+    }
+
+    integrateColumns(m_indices.size(),
+                     m_dt.data(),
+                     m_px.data(),
+                     m_py.data(),
+                     m_vx.data(),
+                     m_vy.data(),
+                     m_ax.data(),
+                     m_ay.data(),
+                     m_fx.data(),
+                     m_fy.data(),
+                     m_invMass.data(),
+                     m_drag.data());
+
+    /* Scatter */
+    for (size_t r = 0; r < m_indices.size(); ++r) {
+        const auto i = m_indices[r];
+        auto &cState = cStates[i];
+
+        cState.position = {m_px[r], m_py[r]};
+        cState.velocity = {m_vx[r], m_vy[r]};
+        cState.acceleration = {m_ax[r], m_ay[r]};
+
+        forces[i].clear();
+    }
+}
+
+} // namespace Physics
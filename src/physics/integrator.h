@@ -0,0 +1,63 @@
+#ifndef JP_PHYSICS_INTEGRATOR_H
+#define JP_PHYSICS_INTEGRATOR_H
+
+#include <vector>
+
+#include "src/entity/components.h"
+#include "src/entity/vector.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Batched integration of the moving entities.
+ *
+ * The moving entities' state is gathered into structure-of-arrays columns
+ * (position, velocity, net force, inverse mass, drag, time step), integrated in a single
+ * branchless pass the compiler can vectorize, and scattered back.
+ * The net force is read from Entity::PhysicsForces, where forces are summed as they are applied.
+ *
+ * Integration is semi-implicit Euler: it solves the same model as @fn KingKutta,
+ * dv/dt = (F - k*v)/m + g, the drag being implicit so the step is unconditionally
+ * stable, v' = (v + (F/m + g)*dt) / (1 + k*dt/m), then x' = x + v'*dt.
+ * Unlike the RK4 path, which stores the integrated velocity as the acceleration and
+ * adds it to the velocity again, acceleration is the actual (v' - v)/dt.
+ */
+class Integrator
+{
+public:
+    /// @brief Entity storage the integrator works on.
+    using Entities = Entity::VectorTypes<Entity::PhysicsEntity>;
+
+    /**
+     * @brief Advances every moving entity by @param timeDelta and clears their forces.
+     * @param dynamicCount Number of moving entities, stored first, the fixed ones are not visited.
+     */
+    void integrate(Entities &entities, size_t dynamicCount, double timeDelta);
+
+private:
+    /// @brief Entity index of each row of the columns.
+    std::vector<int> m_indices{};
+
+    /* Structure of arrays, one row per moving entity */
+
+    std::vector<float> m_px{};
+    std::vector<float> m_py{};
+    std::vector<float> m_vx{};
+    std::vector<float> m_vy{};
+    std::vector<float> m_ax{};
+    std::vector<float> m_ay{};
+    std::vector<float> m_fx{};
+    std::vector<float> m_fy{};
+    std::vector<float> m_invMass{};
+    std::vector<float> m_drag{};
+    /// @brief Time step of each row, longer for the entities the level of detail simulates less often.
+    std::vector<float> m_dt{};
+
+    /// @brief Resizes every column to @param count rows.
+    void resize(size_t count);
+};
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_INTEGRATOR_H
@@ -0,0 +1,66 @@
+#ifndef JP_PHYSICS_ISLANDS_H
+#define JP_PHYSICS_ISLANDS_H
+
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "src/keywords.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Groups entities touching each other, directly or through other entities, in islands.
+ *
+ * Union-find over the entity indices, with path halving and union by size.
+ * Fixed entities must not be linked, or everything standing on the same floor would end up in the same island.
+ */
+class Islands
+{
+public:
+    /// @brief Makes every one of the @param count entities its own island.
+    void reset(const size_t count)
+    {
+        m_parents.resize(count);
+        m_sizes.assign(count, 1);
+        std::iota(m_parents.begin(), m_parents.end(), 0);
+    }
+
+    /// @brief Merges the islands of @param a and @param b.
+    void link(int a, int b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return;
+        }
+
+        if (m_sizes[a] < m_sizes[b]) {
+            std::swap(a, b);
+        }
+        m_parents[b] = a;
+        m_sizes[a] += m_sizes[b];
+    }
+
+    /// @brief Returns the representative entity of the island of @param i.
+    _nodiscard auto find(int i) -> int
+    {
+        while (m_parents[i] != i) {
+            m_parents[i] = m_parents[m_parents[i]];
+            i = m_parents[i];
+        }
+
+        return i;
+    }
+
+private:
+    /// @brief Parent of each entity, roots are their own parent.
+    std::vector<int> m_parents{};
+    /// @brief Number of entities in the island, only meaningful for roots.
+    std::vector<int> m_sizes{};
+};
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_ISLANDS_H
@@ -0,0 +1,226 @@
+#include "src/physics/kernels.h"
+
+#include <algorithm>
+#include <limits>
+#include <span>
+
+#include <ctrack.hpp>
+
+#include "src/physics/projection.h"
+
+namespace
+{
+
+/// @brief Makes @param axis point from @param a to @param b, and fills @param info with it.
+void orientContact(const Physics::PlacedShape &a, const Physics::PlacedShape &b, glm::vec2 axis, const float depth, ::Entity::CollisionInfo &info) noexcept
+{
+    // Use (other.center - center) so a negative dot indicates the axis
+    // points away from the other part and must be inverted.
+    if (const auto centerDelta = b.center() - a.center(); glm::dot(centerDelta, axis) < 0.f) {
+        axis = -axis;
+    }
+
+    info.normal = glm::normalize(axis);
+    info.depth = depth;
+}
+
+} // namespace
+
+namespace Physics
+{
+
+auto boxBox(const PlacedShape &a, const PlacedShape &b, ::Entity::CollisionInfo &info, SeparatingAxis &separating, size_t &axesTested, const TraceScope *trace) noexcept
+    -> bool
+{
+    CTRACK;
+
+    const auto aMin = a.worldMin();
+    const auto aMax = a.worldMax();
+    const auto bMin = b.worldMin();
+    const auto bMax = b.worldMax();
+
+    ++axesTested;
+    if (trace != nullptr) {
+        trace->axis(a.shape.boxAxes[0], 0, 1.f, 0.f, aMin.x, aMax.x, bMin.x, bMax.x);
+    }
+    if (aMax.x < bMin.x || bMax.x < aMin.x) {
+        separating = SeparatingAxis{.index = a.shape.boxAxes[0], .owner = 0};
+        return false;
+    }
+
+    ++axesTested;
+    if (trace != nullptr) {
+        trace->axis(a.shape.boxAxes[1], 0, 0.f, 1.f, aMin.y, aMax.y, bMin.y, bMax.y);
+    }
+    if (aMax.y < bMin.y || bMax.y < aMin.y) {
+        separating = SeparatingAxis{.index = a.shape.boxAxes[1], .owner = 0};
+        return false;
+    }
+
+    const float overlapX = std::min(aMax.x - bMin.x, bMax.x - aMin.x);
+    const float overlapY = std::min(aMax.y - bMin.y, bMax.y - aMin.y);
+    if (overlapX <= overlapY) {
+        orientContact(a, b, {1.f, 0.f}, overlapX, info);
+    } else {
+        orientContact(a, b, {0.f, 1.f}, overlapY, info);
+    }
+
+    return true;
+}
+
+template<bool BoxFirst>
+auto boxConvex(const PlacedShape &a, const PlacedShape &b, ::Entity::CollisionInfo &info, SeparatingAxis &separating, size_t &axesTested, const TraceScope *trace) noexcept
+    -> bool
+{
+    CTRACK;
+
+    const auto &box = BoxFirst ? a : b;
+    const auto &other = BoxFirst ? b : a;
+    constexpr uint8_t boxOwner = BoxFirst ? 0 : 1;
+    constexpr uint8_t otherOwner = 1 - boxOwner;
+
+    const auto boxMin = box.worldMin();
+    const auto boxMax = box.worldMax();
+
+    float minOverlap = std::numeric_limits<float>::max();
+    glm::vec2 smallestAxis{};
+
+    /* The box's axes, the projections of both parts are their bounds */ {
+        const auto otherMin = other.worldMin();
+        const auto otherMax = other.worldMax();
+
+        for (int axis = 0; axis < 2; ++axis) {
+            ++axesTested;
+            if (trace != nullptr) {
+                const float x = axis == 0 ? 1.f : 0.f;
+                if constexpr (BoxFirst) {
+                    trace->axis(box.shape.boxAxes[axis], boxOwner, x, 1.f - x, boxMin[axis], boxMax[axis], otherMin[axis], otherMax[axis]);
+                } else {
+                    trace->axis(box.shape.boxAxes[axis], boxOwner, x, 1.f - x, otherMin[axis], otherMax[axis], boxMin[axis], boxMax[axis]);
+                }
+            }
+            if (boxMax[axis] < otherMin[axis] || otherMax[axis] < boxMin[axis]) {
+                separating = SeparatingAxis{.index = box.shape.boxAxes[axis], .owner = boxOwner};
+                return false;
+            }
+
+            if (const float overlap = std::min(boxMax[axis] - otherMin[axis], otherMax[axis] - boxMin[axis]); overlap < minOverlap) {
+                minOverlap = overlap;
+                smallestAxis = axis == 0 ? glm::vec2{1.f, 0.f} : glm::vec2{0.f, 1.f};
+            }
+        }
+    }
+
+    /* The other part's axes, the box projected from its center */ {
+        const auto boxCenter = (boxMin + boxMax) * 0.5f;
+        const auto boxHalf = (boxMax - boxMin) * 0.5f;
+        const auto normals = other.shape.normals;
+
+        std::array<glm::vec2, projectionBatch> axes{};
+        std::array<float, projectionBatch> mins{};
+        std::array<float, projectionBatch> maxs{};
+
+        for (size_t first = 0; first < normals.size(); first += projectionBatch) {
+            const auto count = std::min(projectionBatch, normals.size() - first);
+            for (size_t k = 0; k < count; ++k) {
+                axes[k] = scaledNormal(normals[first + k], other.scale);
+            }
+
+            projectPolygon(other.shape.xs, other.shape.ys, other.position, other.scale, std::span(axes.data(), count), mins.data(), maxs.data());
+
+            for (size_t k = 0; k < count; ++k) {
+                ++axesTested;
+
+                const float c = glm::dot(boxCenter, axes[k]);
+                const float r = boxHalf.x * std::abs(axes[k].x) + boxHalf.y * std::abs(axes[k].y);
+                if (trace != nullptr) {
+                    const auto index = static_cast<uint32_t>(first + k);
+                    if constexpr (BoxFirst) {
+                        trace->axis(index, otherOwner, axes[k].x, axes[k].y, c - r, c + r, mins[k], maxs[k]);
+                    } else {
+                        trace->axis(index, otherOwner, axes[k].x, axes[k].y, mins[k], maxs[k], c - r, c + r);
+                    }
+                }
+                if (c + r < mins[k] || maxs[k] < c - r) {
+                    separating = SeparatingAxis{.index = static_cast<uint32_t>(first + k), .owner = otherOwner};
+                    return false;
+                }
+
+                if (const float overlap = std::min(c + r - mins[k], maxs[k] - (c - r)); overlap < minOverlap) {
+                    minOverlap = overlap;
+                    smallestAxis = axes[k];
+                }
+            }
+        }
+    }
+
+    orientContact(a, b, smallestAxis, minOverlap, info);
+
+    return true;
+}
+
+template auto boxConvex<true>(const PlacedShape &, const PlacedShape &, ::Entity::CollisionInfo &, SeparatingAxis &, size_t &, const TraceScope *) noexcept -> bool;
+template auto boxConvex<false>(const PlacedShape &, const PlacedShape &, ::Entity::CollisionInfo &, SeparatingAxis &, size_t &, const TraceScope *) noexcept -> bool;
+
+auto convexConvex(const PlacedShape &a, const PlacedShape &b, ::Entity::CollisionInfo &info, SeparatingAxis &separating, size_t &axesTested, const TraceScope *trace) noexcept
+    -> bool
+{
+    CTRACK;
+
+    float minOverlap = std::numeric_limits<float>::max();
+    glm::vec2 smallestAxis{};
+
+    // Projects both shapes onto a batch of axes at once, returns false as soon as one separates them.
+    // @param scale is the scale of the shape the normals come from.
+    const auto testAxes = [&](const std::span<const glm::vec2> normals, const glm::vec2 scale, const uint8_t owner) -> bool {
+        std::array<glm::vec2, projectionBatch> axes{};
+        std::array<float, projectionBatch> aMin{};
+        std::array<float, projectionBatch> aMax{};
+        std::array<float, projectionBatch> bMin{};
+        std::array<float, projectionBatch> bMax{};
+
+        for (size_t first = 0; first < normals.size(); first += projectionBatch) {
+            const auto count = std::min(projectionBatch, normals.size() - first);
+            for (size_t k = 0; k < count; ++k) {
+                axes[k] = scaledNormal(normals[first + k], scale);
+            }
+
+            const auto batch = std::span<const glm::vec2>(axes.data(), count);
+            projectPolygon(a.shape.xs, a.shape.ys, a.position, a.scale, batch, aMin.data(), aMax.data());
+            projectPolygon(b.shape.xs, b.shape.ys, b.position, b.scale, batch, bMin.data(), bMax.data());
+
+            for (size_t k = 0; k < batch.size(); ++k) {
+                const auto &normal = batch[k];
+                ++axesTested;
+
+                if (trace != nullptr) {
+                    trace->axis(static_cast<uint32_t>(first + k), owner, normal.x, normal.y, aMin[k], aMax[k], bMin[k], bMax[k]);
+                }
+
+                // Check if it is separated.
+                if (aMax[k] < bMin[k] || bMax[k] < aMin[k]) {
+                    separating = SeparatingAxis{.index = static_cast<uint32_t>(first + k), .owner = owner};
+                    return false;
+                }
+
+                const float overlap = std::min(aMax[k] - bMin[k], bMax[k] - aMin[k]);
+                if (overlap < minOverlap) {
+                    minOverlap = overlap;
+                    smallestAxis = normal;
+                }
+            }
+        }
+
+        return true;
+    };
+
+    if (!testAxes(a.shape.normals, a.scale, 0) || !testAxes(b.shape.normals, b.scale, 1)) {
+        return false;
+    }
+
+    orientContact(a, b, smallestAxis, minOverlap, info);
+
+    return true;
+}
+
+} // namespace Physics
@@ -0,0 +1,123 @@
+#ifndef JP_PHYSICS_KERNELS_H
+#define JP_PHYSICS_KERNELS_H
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+#include "src/entity/components.h"
+#include "src/keywords.h"
+#include "src/physics/enums.h"
+#include "src/physics/shapepool.h"
+#include "src/physics/trace.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Axis that separated two entities in a SAT test.
+ */
+struct SeparatingAxis
+{
+    /// @brief Index of the normal in its owner's shape, see ShapePool.
+    uint32_t index = 0;
+    /// @brief 0 when the normal belongs to the first entity tested, 1 for the second one.
+    uint8_t owner = 0;
+};
+
+/**
+ * @brief Convex part of a shape placed in the world, as tested by the pair kernels.
+ */
+struct PlacedShape
+{
+    /// @brief Outline of the part.
+    Shape shape{};
+    /// @brief Position of the entity.
+    glm::vec2 position{};
+    /// @brief Scale of the entity.
+    glm::vec2 scale{1.f, 1.f};
+
+    /// @brief Lower corner of the world bounds.
+    _nodiscard auto worldMin() const noexcept { return position + glm::min(shape.min * scale, shape.max * scale); }
+    /// @brief Upper corner of the world bounds.
+    _nodiscard auto worldMax() const noexcept { return position + glm::max(shape.min * scale, shape.max * scale); }
+    /// @brief Center of the world bounds.
+    _nodiscard auto center() const noexcept { return position + (shape.min + shape.max) * 0.5f * scale; }
+};
+
+/// @brief Returns @param normal of an outline once scaled by @param scale.
+_nodiscard inline auto scaledNormal(const glm::vec2 &normal, const glm::vec2 &scale) noexcept
+{
+    // Normals follow the inverse scale to stay perpendicular to their border.
+    return scale == glm::vec2{1.f, 1.f} ? normal : glm::normalize(normal / scale);
+}
+
+/**
+ * @brief Narrow phase test of two convex parts.
+ * Returns true when they overlap, @param info then receiving the contact normal, from the first part to the second
+ * one, and depth. Otherwise @param separating receives the separating axis, indexing the normals of the part it
+ * belongs to. @param axesTested is incremented by the number of axes tested. Every axis is recorded in @param trace,
+ * unless it is null.
+ */
+using PairKernel = auto (*)(const PlacedShape &a,
+                            const PlacedShape &b,
+                            ::Entity::CollisionInfo &info,
+                            SeparatingAxis &separating,
+                            size_t &axesTested,
+                            const TraceScope *trace) noexcept -> bool;
+
+/// @brief Box against box, their bounds are compared, no projection.
+auto boxBox(const PlacedShape &a, const PlacedShape &b, ::Entity::CollisionInfo &info, SeparatingAxis &separating, size_t &axesTested, const TraceScope *trace) noexcept
+    -> bool;
+/**
+ * @brief Box against any convex part, the box being @param a when @tparam BoxFirst, @param b otherwise.
+ * On the box's axes both projections are bounds, on the other part's axes the box is projected from its center and
+ * extents, only the other part's points are projected.
+ */
+template<bool BoxFirst>
+auto boxConvex(const PlacedShape &a, const PlacedShape &b, ::Entity::CollisionInfo &info, SeparatingAxis &separating, size_t &axesTested, const TraceScope *trace) noexcept
+    -> bool;
+/// @brief Any convex parts, full SAT test projecting both on every normal.
+auto convexConvex(const PlacedShape &a, const PlacedShape &b, ::Entity::CollisionInfo &info, SeparatingAxis &separating, size_t &axesTested, const TraceScope *trace) noexcept
+    -> bool;
+
+/// @brief Selects the kernel testing a part of kind @tparam A against a part of kind @tparam B.
+template<ShapeKind A, ShapeKind B>
+consteval auto pairKernel() -> PairKernel
+{
+    static_assert(A != ShapeKind::Compound && B != ShapeKind::Compound, "Compound shapes are tested part by part.");
+
+    if constexpr (A == ShapeKind::Box && B == ShapeKind::Box) {
+        return &boxBox;
+    } else if constexpr (A == ShapeKind::Box) {
+        return &boxConvex<true>;
+    } else if constexpr (B == ShapeKind::Box) {
+        return &boxConvex<false>;
+    } else {
+        // Oriented boxes keep two axes once their parallel normals are merged, the generic test is already minimal.
+        return &convexConvex;
+    }
+}
+
+/// @brief Returns the index of the pair of kinds @param a, @param b in @var pairKernels flattened, and in Stats::kernelPairs.
+_nodiscard constexpr auto pairKernelIndex(const ShapeKind a, const ShapeKind b) noexcept -> size_t
+{
+    return static_cast<size_t>(a) * convexShapeKinds + static_cast<size_t>(b);
+}
+
+/// @brief Kernel of every pair of convex kinds, indexed by [kind of a][kind of b], built at compile time.
+inline constexpr auto pairKernels = []() -> std::array<std::array<PairKernel, convexShapeKinds>, convexShapeKinds> {
+    std::array<std::array<PairKernel, convexShapeKinds>, convexShapeKinds> table{};
+    [&table]<size_t... I>(std::index_sequence<I...>) -> void {
+        ((table[I / convexShapeKinds][I % convexShapeKinds] = pairKernel<static_cast<ShapeKind>(I / convexShapeKinds), static_cast<ShapeKind>(I % convexShapeKinds)>()),
+         ...);
+    }(std::make_index_sequence<convexShapeKinds * convexShapeKinds>{});
+    return table;
+}();
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_KERNELS_H
@@ -0,0 +1,390 @@
+#include "src/physics/outline.h"
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <ranges>
+#include <utility>
+
+#include "src/physics/query.h"
+
+namespace
+{
+
+/// @brief Z component of the cross product of @param a and @param b.
+auto cross(const glm::vec2 a, const glm::vec2 b) -> float
+{
+    return a.x * b.y - a.y * b.x;
+}
+
+/// @brief Twice the signed area of @param polygon, positive when counter-clockwise.
+auto signedArea(const std::span<const glm::vec2> polygon) -> float
+{
+    float area = 0.f;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        area += cross(polygon[j], polygon[i]);
+    }
+    return area;
+}
+
+/// @brief Distance between @param p and the segment [@param a, @param b].
+auto segmentDistance(const glm::vec2 p, const glm::vec2 a, const glm::vec2 b) -> float
+{
+    const auto ab = b - a;
+    const float length2 = glm::dot(ab, ab);
+    if (length2 <= Config::eps2) {
+        return glm::length(p - a);
+    }
+
+    const float t = std::clamp(glm::dot(p - a, ab) / length2, 0.f, 1.f);
+    return glm::length(p - a - ab * t);
+}
+
+/// @brief Returns true if @param p is inside the counter-clockwise triangle (@param a, @param b, @param c), borders included.
+auto inTriangle(const glm::vec2 p, const glm::vec2 a, const glm::vec2 b, const glm::vec2 c) -> bool
+{
+    return cross(b - a, p - a) >= 0.f && cross(c - b, p - b) >= 0.f && cross(a - c, p - c) >= 0.f;
+}
+
+/// @brief Returns true if the counter-clockwise polygon @param indices of @param points has no reflex vertex.
+auto isConvex(const std::span<const glm::vec2> points, const std::span<const size_t> indices) -> bool
+{
+    const auto count = indices.size();
+    for (size_t i = 0; i < count; ++i) {
+        const auto a = points[indices[i]];
+        const auto b = points[indices[(i + 1) % count]];
+        const auto c = points[indices[(i + 2) % count]];
+        if (cross(b - a, c - b) < -Config::physicsEpsilon) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+namespace Physics
+{
+
+auto splitPaths(const std::span<const glm::vec2> points) -> std::vector<std::vector<glm::vec2>>
+{
+    std::vector<std::vector<glm::vec2>> paths{};
+
+    size_t start = 0;
+    while (start < points.size()) {
+        size_t end = start + 1;
+        while (end < points.size() && points[end] != points[start]) {
+            ++end;
+        }
+
+        paths.emplace_back(points.begin() + static_cast<std::ptrdiff_t>(start), points.begin() + static_cast<std::ptrdiff_t>(end));
+        start = end + 1;
+    }
+
+    return paths;
+}
+
+auto simplifyPath(const std::span<const glm::vec2> path, const float tolerance) -> std::vector<glm::vec2>
+{
+    const auto count = path.size();
+    if (tolerance <= 0.f || count < 4) {
+        return {path.begin(), path.end()};
+    }
+
+    // The path is closed, it is split at the point the farthest from its first one, both halves being simplified.
+    size_t farthest = 0;
+    float farthestDistance = 0.f;
+    for (size_t i = 1; i < count; ++i) {
+        if (const float d = glm::length(path[i] - path[0]); d > farthestDistance) {
+            farthest = i;
+            farthestDistance = d;
+        }
+    }
+
+    std::vector<uint8_t> keep(count, 0);
+    keep[0] = 1;
+    keep[farthest] = 1;
+
+    // Index count stands for the first point again.
+    const auto at = [&path, count](const size_t i) -> glm::vec2 { return path[i % count]; };
+
+    std::vector<std::pair<size_t, size_t>> ranges{{0, farthest}, {farthest, count}};
+    while (!ranges.empty()) {
+        const auto [first, last] = ranges.back();
+        ranges.pop_back();
+
+        size_t split = first;
+        float splitDistance = tolerance;
+        for (size_t i = first + 1; i < last; ++i) {
+            if (const float d = segmentDistance(at(i), at(first), at(last)); d > splitDistance) {
+                split = i;
+                splitDistance = d;
+            }
+        }
+
+        if (split != first) {
+            keep[split] = 1;
+            ranges.emplace_back(first, split);
+            ranges.emplace_back(split, last);
+        }
+    }
+
+    std::vector<glm::vec2> simplified{};
+    for (size_t i = 0; i < count; ++i) {
+        if (keep[i]) {
+            simplified.push_back(path[i]);
+        }
+    }
+
+    return simplified;
+}
+
+auto removeCollinear(std::vector<glm::vec2> path, const float angle) -> std::vector<glm::vec2>
+{
+    const float sinTolerance = std::sin(angle);
+
+    bool changed = true;
+    while (changed && path.size() > 3) {
+        changed = false;
+
+        for (size_t i = 0; i < path.size() && path.size() > 3;) {
+            const auto count = path.size();
+            const auto in = path[i] - path[(i + count - 1) % count];
+            const auto out = path[(i + 1) % count] - path[i];
+            const float inLength = glm::length(in);
+            const float outLength = glm::length(out);
+
+            // Duplicates, and points in the middle of a straight border going on in the same direction.
+            const bool duplicate = inLength <= Config::physicsEpsilon || outLength <= Config::physicsEpsilon;
+            if (duplicate || (glm::dot(in, out) > 0.f && std::abs(cross(in, out)) <= sinTolerance * inLength * outLength)) {
+                path.erase(path.begin() + static_cast<std::ptrdiff_t>(i));
+                changed = true;
+                continue;
+            }
+
+            ++i;
+        }
+    }
+
+    return path;
+}
+
+auto convexHull(const std::span<const glm::vec2> points) -> std::vector<glm::vec2>
+{
+    std::vector<glm::vec2> sorted(points.begin(), points.end());
+    std::ranges::sort(sorted, [](const glm::vec2 a, const glm::vec2 b) -> bool { return a.x < b.x || (a.x == b.x && a.y < b.y); });
+    const auto [first, last] = std::ranges::unique(sorted);
+    sorted.erase(first, last);
+
+    if (sorted.size() < 3) {
+        return sorted;
+    }
+
+    // Andrew's monotone chain, lower hull then upper hull.
+    std::vector<glm::vec2> hull(sorted.size() * 2);
+    size_t k = 0;
+    for (const auto &p : sorted) {
+        while (k >= 2 && cross(hull[k - 1] - hull[k - 2], p - hull[k - 2]) <= 0.f) {
+            --k;
+        }
+        hull[k++] = p;
+    }
+    for (size_t i = sorted.size() - 1, lower = k + 1; i > 0; --i) {
+        const auto &p = sorted[i - 1];
+        while (k >= lower && cross(hull[k - 1] - hull[k - 2], p - hull[k - 2]) <= 0.f) {
+            --k;
+        }
+        hull[k++] = p;
+    }
+    // The first point was added again at the end.
+    hull.resize(k - 1);
+
+    return hull;
+}
+
+auto decomposeConvex(const std::span<const glm::vec2> path) -> std::vector<std::vector<glm::vec2>>
+{
+    const auto count = path.size();
+    if (count < 3) {
+        return {};
+    }
+
+    std::vector<glm::vec2> points(path.begin(), path.end());
+    if (signedArea(points) < 0.f) {
+        std::ranges::reverse(points);
+    }
+
+    std::vector<std::vector<size_t>> polygons{};
+
+    /* Ear clipping triangulation */ {
+        std::vector<size_t> remaining(count);
+        std::iota(remaining.begin(), remaining.end(), 0);
+
+        while (remaining.size() > 3) {
+            const auto size = remaining.size();
+            bool clipped = false;
+
+            for (size_t k = 0; k < size && !clipped; ++k) {
+                const auto prev = remaining[(k + size - 1) % size];
+                const auto curr = remaining[k];
+                const auto next = remaining[(k + 1) % size];
+                const auto a = points[prev];
+                const auto b = points[curr];
+                const auto c = points[next];
+
+                // Reflex or flat vertex, not an ear.
+                if (cross(b - a, c - b) <= Config::physicsEpsilon) {
+                    continue;
+                }
+
+                const bool containsOther = std::ranges::any_of(remaining, [&](const size_t other) -> bool {
+                    return other != prev && other != curr && other != next && inTriangle(points[other], a, b, c);
+                });
+                if (containsOther) {
+                    continue;
+                }
+
+                polygons.push_back({prev, curr, next});
+                remaining.erase(remaining.begin() + static_cast<std::ptrdiff_t>(k));
+                clipped = true;
+            }
+
+            // Self-intersecting path.
+            if (!clipped) {
+                return {};
+            }
+        }
+
+        polygons.push_back(remaining);
+    }
+
+    /* Hertel-Mehlhorn, removes the diagonals whose polygons stay convex once merged */ {
+        bool merged = true;
+        while (merged) {
+            merged = false;
+
+            for (size_t i = 0; i < polygons.size() && !merged; ++i) {
+                for (size_t j = i + 1; j < polygons.size() && !merged; ++j) {
+                    const auto &a = polygons[i];
+                    const auto &b = polygons[j];
+
+                    for (size_t ka = 0; ka < a.size() && !merged; ++ka) {
+                        const auto u = a[ka];
+                        const auto v = a[(ka + 1) % a.size()];
+
+                        // Both polygons are counter-clockwise, the shared diagonal goes the other way in b.
+                        const auto kb = std::ranges::find(b, v) - b.begin();
+                        if (static_cast<size_t>(kb) == b.size() || b[(kb + 1) % b.size()] != u) {
+                            continue;
+                        }
+
+                        // a from v around to u, then b without u and v.
+                        std::vector<size_t> candidate{};
+                        candidate.reserve(a.size() + b.size() - 2);
+                        for (size_t k = 1; k <= a.size(); ++k) {
+                            candidate.push_back(a[(ka + k) % a.size()]);
+                        }
+                        for (size_t k = 2; k < b.size(); ++k) {
+                            candidate.push_back(b[(kb + k) % b.size()]);
+                        }
+
+                        if (isConvex(points, candidate)) {
+                            polygons[i] = std::move(candidate);
+                            polygons.erase(polygons.begin() + static_cast<std::ptrdiff_t>(j));
+                            merged = true;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<std::vector<glm::vec2>> parts{};
+    parts.reserve(polygons.size());
+    for (const auto &polygon : polygons) {
+        auto &part = parts.emplace_back();
+        part.reserve(polygon.size());
+        for (const auto index : polygon) {
+            part.push_back(points[index]);
+        }
+    }
+
+    return parts;
+}
+
+auto convexNormals(const std::span<const glm::vec2> polygon, const float angle) -> std::vector<glm::vec2>
+{
+    const float cosTolerance = std::cos(angle);
+    std::vector<glm::vec2> normals{};
+
+    for (size_t i = 0; i < polygon.size(); ++i) {
+        const auto edge = polygon[(i + 1) % polygon.size()] - polygon[i];
+        if (glm::dot(edge, edge) <= Config::eps2) {
+            continue;
+        }
+
+        // Counter-clockwise, the interior is on the left of the borders.
+        const auto normal = glm::normalize(glm::vec2{edge.y, -edge.x});
+
+        // A normal and its opposite give the same SAT axis.
+        const bool known = std::ranges::any_of(normals, [&normal, cosTolerance](const glm::vec2 &other) -> bool {
+            return std::abs(glm::dot(normal, other)) >= cosTolerance;
+        });
+        if (!known) {
+            normals.push_back(normal);
+        }
+    }
+
+    return normals;
+}
+
+auto buildConvexParts(const std::span<const glm::vec2> points, const OutlineTolerances &tolerances) -> std::vector<ConvexPart>
+{
+    const auto paths = splitPaths(points);
+
+    std::vector<std::vector<glm::vec2>> polygons{};
+    bool decomposed = true;
+
+    for (size_t i = 0; i < paths.size() && decomposed; ++i) {
+        const auto &path = paths[i];
+
+        // Holes lie in another path, the shape is considered filled.
+        const bool hole = std::ranges::any_of(std::views::iota(size_t(0), paths.size()), [&paths, &path, i](const size_t j) -> bool {
+            return j != i && paths[j].size() >= 3 && pointInPolygon(path[0], {}, paths[j], {1.f, 1.f});
+        });
+        if (hole || path.size() < 3) {
+            continue;
+        }
+
+        const auto simplified = removeCollinear(simplifyPath(path, tolerances.simplify), tolerances.angle);
+        if (simplified.size() < 3) {
+            continue;
+        }
+
+        auto convex = decomposeConvex(simplified);
+        decomposed = !convex.empty();
+        polygons.append_range(std::move(convex));
+    }
+
+    if (!decomposed || polygons.empty() || polygons.size() > tolerances.maxParts) {
+        polygons = {convexHull(points)};
+    }
+
+    std::vector<ConvexPart> parts{};
+    parts.reserve(polygons.size());
+    for (auto &polygon : polygons) {
+        if (polygon.empty()) {
+            continue;
+        }
+
+        auto normals = convexNormals(polygon, tolerances.angle);
+        parts.push_back(ConvexPart{.borders = std::move(polygon), .normals = std::move(normals)});
+    }
+
+    return parts;
+}
+
+} // namespace Physics
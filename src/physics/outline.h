@@ -0,0 +1,66 @@
+#ifndef JP_PHYSICS_OUTLINE_H
+#define JP_PHYSICS_OUTLINE_H
+
+#include <glm/vec2.hpp>
+
+#include <span>
+#include <vector>
+
+#include "src/config.h"
+#include "src/physics/shapepool.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Tolerances used to turn a traced outline into a collision shape, set per resource.
+ */
+struct OutlineTolerances
+{
+    /// @brief Largest distance between the outline and its simplification, 0 keeps every point.
+    float simplify = Config::outlineSimplifyTolerance;
+    /// @brief Largest angle, in radians, between two borders merged as collinear, or two normals merged in one axis.
+    float angle = Config::outlineAngleTolerance;
+    /// @brief Largest number of convex parts, the convex hull of the outline is used beyond.
+    size_t maxParts = Config::outlineMaxConvexParts;
+};
+
+/**
+ * @brief Splits the paths of an outline made by ImageVectorizer, each one being closed by a copy of its first point.
+ * @return The paths, without their closing point.
+ */
+_nodiscard auto splitPaths(std::span<const glm::vec2> points) -> std::vector<std::vector<glm::vec2>>;
+
+/**
+ * @brief Ramer-Douglas-Peucker simplification of the closed path @param path.
+ * @param tolerance Largest distance between a removed point and the simplified path.
+ */
+_nodiscard auto simplifyPath(std::span<const glm::vec2> path, float tolerance) -> std::vector<glm::vec2>;
+
+/// @brief Removes the duplicate points of the closed path @param path, and the points between borders closer than @param angle.
+_nodiscard auto removeCollinear(std::vector<glm::vec2> path, float angle) -> std::vector<glm::vec2>;
+
+/// @brief Returns the convex hull of @param points, counter-clockwise.
+_nodiscard auto convexHull(std::span<const glm::vec2> points) -> std::vector<glm::vec2>;
+
+/**
+ * @brief Splits the simple polygon @param path in convex polygons (Hertel-Mehlhorn).
+ * The polygon is triangulated by ear clipping, then the triangles are merged back as long as the result stays convex.
+ * @return Counter-clockwise convex polygons, empty if @param path could not be triangulated.
+ */
+_nodiscard auto decomposeConvex(std::span<const glm::vec2> path) -> std::vector<std::vector<glm::vec2>>;
+
+/// @brief Returns the outward normals of the counter-clockwise convex polygon @param polygon, parallel ones given once.
+_nodiscard auto convexNormals(std::span<const glm::vec2> polygon, float angle) -> std::vector<glm::vec2>;
+
+/**
+ * @brief Turns an outline made by ImageVectorizer into convex parts for the ShapePool.
+ *
+ * Holes are dropped, each outer path is simplified, and decomposed in convex parts. When the outline needs more than
+ * @var OutlineTolerances::maxParts parts, or cannot be decomposed, the convex hull of its points is used instead.
+ */
+_nodiscard auto buildConvexParts(std::span<const glm::vec2> points, const OutlineTolerances &tolerances) -> std::vector<ConvexPart>;
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_OUTLINE_H
@@ -0,0 +1,132 @@
+#ifndef JP_PHYSICS_PAIRMAP_H
+#define JP_PHYSICS_PAIRMAP_H
+
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "src/keywords.h"
+#include "src/physics/pairset.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Open-addressing hash map from entity pairs (@fn pairKey) to @param V.
+ *
+ * Same layout as @ref PairSet, values stored next to their key. Meant to be filled once per step and read
+ * during the next one: @fn clear keeps the capacity, and @fn find may be called from several threads as
+ * long as nobody writes.
+ */
+template<typename V>
+class PairMap
+{
+public:
+    /// @brief Builds a map able to hold @param capacity pairs before growing.
+    explicit PairMap(const size_t capacity = 64) { rehash(std::bit_ceil(capacity * 2)); }
+
+    /// @brief Sets the value of @param key, inserting it if needed.
+    void insertOrAssign(const uint64_t key, const V &value)
+    {
+        assert(key != emptySlot);
+
+        if ((m_used.size() + 1) * 2 > m_slots.size()) {
+            rehash(m_slots.size() * 2);
+        }
+
+        auto slot = slotOf(key);
+        while (m_slots[slot].first != emptySlot) {
+            if (m_slots[slot].first == key) {
+                m_slots[slot].second = value;
+                return;
+            }
+            slot = (slot + 1) & m_mask;
+        }
+
+        m_slots[slot] = {key, value};
+        m_used.push_back(slot);
+    }
+
+    /// @brief Returns the value of @param key, nullptr if it is not in the map.
+    _nodiscard auto find(const uint64_t key) const -> const V *
+    {
+        auto slot = slotOf(key);
+        while (m_slots[slot].first != emptySlot) {
+            if (m_slots[slot].first == key) {
+                return &m_slots[slot].second;
+            }
+            slot = (slot + 1) & m_mask;
+        }
+
+        return nullptr;
+    }
+
+    /// @brief Removes every entry, keeping the allocated storage.
+    void clear()
+    {
+        for (const auto slot : m_used) {
+            m_slots[slot].first = emptySlot;
+        }
+        m_used.clear();
+    }
+
+    /// @brief Number of entries in the map.
+    _nodiscard auto size() const -> size_t { return m_used.size(); }
+
+    /// @brief Number of times the storage has been (re)allocated since construction.
+    _nodiscard auto allocations() const -> size_t { return m_allocations; }
+
+    /// @brief Exchanges the content of two maps, no allocation involved.
+    void swap(PairMap &other) noexcept
+    {
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_used, other.m_used);
+        std::swap(m_mask, other.m_mask);
+        std::swap(m_allocations, other.m_allocations);
+    }
+
+private:
+    /// @brief Marker of an empty slot, no valid pair packs to it.
+    static constexpr uint64_t emptySlot = ~uint64_t(0);
+
+    /// @brief Hash table, @var emptySlot keys mark free slots.
+    std::vector<std::pair<uint64_t, V>> m_slots{};
+    /// @brief Slots in use, in insertion order.
+    std::vector<size_t> m_used{};
+    /// @brief Mask applied to hashes, table size minus one.
+    size_t m_mask = 0;
+    /// @brief Number of (re)allocations of the table.
+    size_t m_allocations = 0;
+
+    /// @brief Home slot of a key.
+    _nodiscard auto slotOf(const uint64_t key) const -> size_t { return static_cast<size_t>(pairHash(key)) & m_mask; }
+
+    /// @brief Grows the table to @param slotCount slots and re-inserts the entries.
+    void rehash(const size_t slotCount)
+    {
+        auto previous = std::move(m_slots);
+        const auto used = std::move(m_used);
+
+        m_slots.assign(slotCount, {emptySlot, V{}});
+        m_mask = slotCount - 1;
+        m_used.clear();
+        m_used.reserve(slotCount / 2);
+        ++m_allocations;
+
+        for (const auto slot : used) {
+            auto &[key, value] = previous[slot];
+            auto target = slotOf(key);
+            while (m_slots[target].first != emptySlot) {
+                target = (target + 1) & m_mask;
+            }
+            m_slots[target] = {key, std::move(value)};
+            m_used.push_back(target);
+        }
+    }
+};
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_PAIRMAP_H
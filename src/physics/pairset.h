@@ -0,0 +1,171 @@
+#ifndef JP_PHYSICS_PAIRSET_H
+#define JP_PHYSICS_PAIRSET_H
+
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "src/keywords.h"
+
+namespace Physics
+{
+
+/// @brief Packs a pair of entity indices into a 64-bit key, the lowest index in the high bits.
+_nodiscard constexpr auto pairKey(const int a, const int b) noexcept -> uint64_t
+{
+    const auto lo = static_cast<uint32_t>(a < b ? a : b);
+    const auto hi = static_cast<uint32_t>(a < b ? b : a);
+    return static_cast<uint64_t>(lo) << 32 | hi;
+}
+
+/// @brief Returns the lowest entity index of a key built by @fn pairKey.
+_nodiscard constexpr auto pairFirst(const uint64_t key) noexcept -> int
+{
+    return static_cast<int>(key >> 32);
+}
+
+/// @brief Returns the highest entity index of a key built by @fn pairKey.
+_nodiscard constexpr auto pairSecond(const uint64_t key) noexcept -> int
+{
+    return static_cast<int>(key & 0xFFFFFFFFu);
+}
+
+/// @brief Mixes the bits of a pair key, 64-bit finalizer of MurmurHash3.
+_nodiscard constexpr auto pairHash(uint64_t key) noexcept -> uint64_t
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+/**
+ * @brief Open-addressing hash set of entity pairs.
+ *
+ * Keys are stored inline in a power-of-two table with linear probing, and also
+ * listed in insertion order so that clearing and iterating cost O(size), not
+ * O(capacity). The capacity is kept through @fn clear, so once the set has grown
+ * to the usual number of contacts, a tick does not allocate anymore.
+ */
+class PairSet
+{
+public:
+    /// @brief Builds a set able to hold @param capacity pairs before growing.
+    explicit PairSet(const size_t capacity = 64) { rehash(std::bit_ceil(capacity * 2)); }
+
+    /// @brief Inserts a key, returns false if it was already present.
+    auto insert(const uint64_t key) -> bool
+    {
+        assert(key != emptySlot);
+
+        // Keep the load factor under 1/2, probe sequences stay short.
+        if ((m_keys.size() + 1) * 2 > m_slots.size()) {
+            rehash(m_slots.size() * 2);
+        }
+
+        auto slot = slotOf(key);
+        while (m_slots[slot] != emptySlot) {
+            if (m_slots[slot] == key) {
+                return false;
+            }
+            slot = (slot + 1) & m_mask;
+        }
+
+        m_slots[slot] = key;
+        m_keys.push_back(key);
+        m_used.push_back(slot);
+
+        return true;
+    }
+
+    /// @brief Returns true if the key is in the set.
+    _nodiscard auto contains(const uint64_t key) const -> bool
+    {
+        auto slot = slotOf(key);
+        while (m_slots[slot] != emptySlot) {
+            if (m_slots[slot] == key) {
+                return true;
+            }
+            slot = (slot + 1) & m_mask;
+        }
+
+        return false;
+    }
+
+    /// @brief Removes every key, keeping the allocated storage.
+    void clear()
+    {
+        for (const auto slot : m_used) {
+            m_slots[slot] = emptySlot;
+        }
+        m_keys.clear();
+        m_used.clear();
+    }
+
+    /// @brief Number of keys in the set.
+    _nodiscard auto size() const -> size_t { return m_keys.size(); }
+    /// @brief Returns true if the set is empty.
+    _nodiscard auto empty() const -> bool { return m_keys.empty(); }
+    /// @brief Keys in insertion order.
+    _nodiscard auto keys() const -> std::span<const uint64_t> { return m_keys; }
+
+    /// @brief Number of times the storage has been (re)allocated since construction.
+    _nodiscard auto allocations() const -> size_t { return m_allocations; }
+
+    /// @brief Exchanges the content of two sets, no allocation involved.
+    void swap(PairSet &other) noexcept
+    {
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_keys, other.m_keys);
+        std::swap(m_used, other.m_used);
+        std::swap(m_mask, other.m_mask);
+        std::swap(m_allocations, other.m_allocations);
+    }
+
+private:
+    /// @brief Marker of an empty slot, no valid pair packs to it.
+    static constexpr uint64_t emptySlot = ~uint64_t(0);
+
+    /// @brief Hash table, @var emptySlot marks free slots.
+    std::vector<uint64_t> m_slots{};
+    /// @brief Keys in insertion order.
+    std::vector<uint64_t> m_keys{};
+    /// @brief Slots used by @var m_keys, same order.
+    std::vector<size_t> m_used{};
+    /// @brief Mask applied to hashes, table size minus one.
+    size_t m_mask = 0;
+    /// @brief Number of (re)allocations of the table.
+    size_t m_allocations = 0;
+
+    /// @brief Home slot of a key.
+    _nodiscard auto slotOf(const uint64_t key) const -> size_t { return static_cast<size_t>(pairHash(key)) & m_mask; }
+
+    /// @brief Grows the table to @param slotCount slots and re-inserts the keys.
+    void rehash(const size_t slotCount)
+    {
+        m_slots.assign(slotCount, emptySlot);
+        m_mask = slotCount - 1;
+        m_keys.reserve(slotCount / 2);
+        m_used.reserve(slotCount / 2);
+        m_used.clear();
+        ++m_allocations;
+
+        for (const auto key : m_keys) {
+            auto slot = slotOf(key);
+            while (m_slots[slot] != emptySlot) {
+                slot = (slot + 1) & m_mask;
+            }
+            m_slots[slot] = key;
+            m_used.push_back(slot);
+        }
+    }
+};
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_PAIRSET_H
@@ -0,0 +1,91 @@
+#include "src/physics/projection.h"
+
+#include <glm/geometric.hpp>
+
+#include <array>
+#include <cassert>
+#include <limits>
+
+#if (defined(__AVX2__) || defined(__SSE2__)) && !defined(JP_PROJECTION_SCALAR)
+#include <immintrin.h>
+#endif
+
+namespace Physics
+{
+
+void projectPolygon(const std::span<const float> xs,
+                    const std::span<const float> ys,
+                    const glm::vec2 offset,
+                    const glm::vec2 scale,
+                    const std::span<const glm::vec2> axes,
+                    float *mins,
+                    float *maxs) noexcept
+{
+    assert(xs.size() == ys.size());
+    assert(!xs.empty());
+    assert(axes.size() <= projectionBatch);
+    assert(mins != nullptr && maxs != nullptr);
+
+    // Pad the unused lanes with a null axis, their results are simply not written back.
+    // dot(p * scale, axis) is dot(p, axis * scale), the scale is folded in the axes once.
+    alignas(32) std::array<float, projectionBatch> axisX{};
+    alignas(32) std::array<float, projectionBatch> axisY{};
+    for (size_t k = 0; k < axes.size(); ++k) {
+        axisX[k] = axes[k].x * scale.x;
+        axisY[k] = axes[k].y * scale.y;
+    }
+
+    alignas(32) std::array<float, projectionBatch> lo{};
+    alignas(32) std::array<float, projectionBatch> hi{};
+    const auto count = xs.size();
+
+#if defined(__AVX2__) && !defined(JP_PROJECTION_SCALAR)
+    const __m256 ax = _mm256_load_ps(axisX.data());
+    const __m256 ay = _mm256_load_ps(axisY.data());
+    __m256 vlo = _mm256_set1_ps(std::numeric_limits<float>::max());
+    __m256 vhi = _mm256_set1_ps(std::numeric_limits<float>::lowest());
+
+    for (size_t i = 0; i < count; ++i) {
+        const __m256 p = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(xs[i]), ax), _mm256_mul_ps(_mm256_set1_ps(ys[i]), ay));
+        vlo = _mm256_min_ps(vlo, p);
+        vhi = _mm256_max_ps(vhi, p);
+    }
+
+    _mm256_store_ps(lo.data(), vlo);
+    _mm256_store_ps(hi.data(), vhi);
+#elif defined(__SSE2__) && !defined(JP_PROJECTION_SCALAR)
+    const __m128 ax = _mm_load_ps(axisX.data());
+    const __m128 ay = _mm_load_ps(axisY.data());
+    __m128 vlo = _mm_set1_ps(std::numeric_limits<float>::max());
+    __m128 vhi = _mm_set1_ps(std::numeric_limits<float>::lowest());
+
+    for (size_t i = 0; i < count; ++i) {
+        const __m128 p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(xs[i]), ax), _mm_mul_ps(_mm_set1_ps(ys[i]), ay));
+        vlo = _mm_min_ps(vlo, p);
+        vhi = _mm_max_ps(vhi, p);
+    }
+
+    _mm_store_ps(lo.data(), vlo);
+    _mm_store_ps(hi.data(), vhi);
+#else
+    lo.fill(std::numeric_limits<float>::max());
+    hi.fill(std::numeric_limits<float>::lowest());
+
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t k = 0; k < projectionBatch; ++k) {
+            const float p = xs[i] * axisX[k] + ys[i] * axisY[k];
+            lo[k] = p < lo[k] ? p : lo[k];
+            hi[k] = p > hi[k] ? p : hi[k];
+        }
+    }
+#endif
+
+    // Translation only shifts the projection, apply it once per axis instead of once per vertex.
+    for (size_t k = 0; k < axes.size(); ++k) {
+        const float shift = glm::dot(offset, axes[k]);
+        mins[k] = lo[k] + shift;
+        maxs[k] = hi[k] + shift;
+    }
+}
+
+} // namespace Physics
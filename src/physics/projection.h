@@ -0,0 +1,47 @@
+#ifndef JP_PHYSICS_PROJECTION_H
+#define JP_PHYSICS_PROJECTION_H
+
+#include <glm/vec2.hpp>
+
+#include <cstddef>
+#include <span>
+
+namespace Physics
+{
+
+/**
+ * @brief Number of axes projected at once by @fn projectPolygon.
+ * Matches the width of the instruction set the kernel is compiled for:
+ * 8 floats with AVX2, 4 with SSE2, 4 for the scalar fallback (loops are unrolled on it).
+ * Defining JP_PROJECTION_SCALAR forces the scalar fallback, the benchmarks compare it with the SIMD kernels.
+ */
+#if defined(__AVX2__) && !defined(JP_PROJECTION_SCALAR)
+inline constexpr size_t projectionBatch = 8;
+#else
+inline constexpr size_t projectionBatch = 4;
+#endif
+
+/**
+ * @brief Projects a polygon onto several axes at once.
+ * @param xs X coordinates of the polygon's vertices, relative to @param offset.
+ * @param ys Y coordinates of the polygon's vertices, relative to @param offset.
+ * @param offset Position of the polygon in world space.
+ * @param scale Scale applied to the vertices along each axis, before the translation.
+ * @param axes Axes to project onto, at most @var projectionBatch.
+ * @param mins Receives the minimum projection onto each axis, one per axis.
+ * @param maxs Receives the maximum projection onto each axis, one per axis.
+ *
+ * The SSE2/AVX2/scalar implementation is chosen at compile time, depending on the
+ * instruction sets enabled for the target (e.g. -mavx2).
+ */
+void projectPolygon(std::span<const float> xs,
+                    std::span<const float> ys,
+                    glm::vec2 offset,
+                    glm::vec2 scale,
+                    std::span<const glm::vec2> axes,
+                    float *mins,
+                    float *maxs) noexcept;
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_PROJECTION_H
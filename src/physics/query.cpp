@@ -0,0 +1,107 @@
+#include "src/physics/query.h"
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace Physics
+{
+
+auto rayAABB(const glm::vec2 origin, const glm::vec2 delta, const Entity::AABB &bounds, const float maxFraction) noexcept -> float
+{
+    constexpr float miss = std::numeric_limits<float>::max();
+
+    float entry = 0.f;
+    float exit = maxFraction;
+
+    for (int axis = 0; axis < 2; ++axis) {
+        if (delta[axis] == 0.f) {
+            if (origin[axis] < bounds.min[axis] || origin[axis] > bounds.max[axis]) {
+                return miss;
+            }
+            continue;
+        }
+
+        const float inverse = 1.f / delta[axis];
+        float t0 = (bounds.min[axis] - origin[axis]) * inverse;
+        float t1 = (bounds.max[axis] - origin[axis]) * inverse;
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+
+        entry = std::max(entry, t0);
+        exit = std::min(exit, t1);
+        if (entry > exit) {
+            return miss;
+        }
+    }
+
+    return entry;
+}
+
+auto rayPolygon(const glm::vec2 origin,
+                const glm::vec2 delta,
+                const glm::vec2 position,
+                const std::span<const glm::vec2> borders,
+                const glm::vec2 scale,
+                const float maxFraction,
+                glm::vec2 &normal) noexcept -> float
+{
+    constexpr float miss = std::numeric_limits<float>::max();
+
+    float closest = miss;
+    const auto count = borders.size();
+    if (count < 2) {
+        return miss;
+    }
+
+    const auto cross = [](const glm::vec2 a, const glm::vec2 b) -> float { return a.x * b.y - a.y * b.x; };
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto a = position + borders[i] * scale;
+        const auto b = position + borders[(i + 1) % count] * scale;
+        const auto edge = b - a;
+
+        const float denominator = cross(delta, edge);
+        // Parallel to the border, the neighbouring borders are hit instead.
+        if (denominator == 0.f) {
+            continue;
+        }
+
+        const auto toEdge = a - origin;
+        const float t = cross(toEdge, edge) / denominator;
+        const float u = cross(toEdge, delta) / denominator;
+
+        if (t >= 0.f && t <= maxFraction && t < closest && u >= 0.f && u <= 1.f) {
+            closest = t;
+            normal = glm::normalize(glm::vec2{-edge.y, edge.x});
+        }
+    }
+
+    if (closest != miss && glm::dot(normal, delta) > 0.f) {
+        normal = -normal;
+    }
+
+    return closest;
+}
+
+auto pointInPolygon(const glm::vec2 point, const glm::vec2 position, const std::span<const glm::vec2> borders, const glm::vec2 scale) noexcept -> bool
+{
+    bool inside = false;
+    const auto count = borders.size();
+
+    for (size_t i = 0, j = count - 1; i < count; j = i++) {
+        const auto a = position + borders[i] * scale;
+        const auto b = position + borders[j] * scale;
+
+        if ((a.y > point.y) != (b.y > point.y) && point.x < (b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x) {
+            inside = !inside;
+        }
+    }
+
+    return inside;
+}
+
+} // namespace Physics
@@ -0,0 +1,69 @@
+#ifndef JP_PHYSICS_QUERY_H
+#define JP_PHYSICS_QUERY_H
+
+#include <glm/vec2.hpp>
+
+#include <cstdint>
+#include <span>
+
+#include "src/entity/components.h"
+#include "src/keywords.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Segment cast through the scene, from @var origin to @var origin + @var delta.
+ */
+struct RayQuery
+{
+    /// @brief Start of the segment.
+    glm::vec2 origin{};
+    /// @brief Motion from the start to the end of the segment.
+    glm::vec2 delta{};
+    /// @brief Collision layers that may be hit, compared with the entities' category.
+    uint32_t mask = ~uint32_t(0);
+};
+
+/**
+ * @brief Closest entity hit by a @ref RayQuery.
+ */
+struct RayHit
+{
+    /// @brief Entity hit, -1 when nothing was.
+    int entity = -1;
+    /// @brief Fraction of the segment at which the entity is hit, in [0, 1].
+    float fraction = 1.f;
+    /// @brief World position of the hit.
+    glm::vec2 point{};
+    /// @brief Normal of the border hit.
+    glm::vec2 normal{};
+};
+
+/**
+ * @brief Returns the fraction of @param delta at which a segment starting at @param origin enters @param bounds.
+ * @return A value above @param maxFraction when it does not enter it before, 0 when it starts inside.
+ */
+_nodiscard auto rayAABB(glm::vec2 origin, glm::vec2 delta, const Entity::AABB &bounds, float maxFraction) noexcept -> float;
+
+/**
+ * @brief Returns the fraction of @param delta at which a segment starting at @param origin crosses an outline.
+ * @param borders Outline points, relative to @param position, the last edge closes it when the first point is not repeated.
+ * @param scale Scale applied to @param borders along each axis.
+ * @param normal Receives the normal of the crossed border, facing the segment.
+ * @return A value above @param maxFraction when it does not cross it before.
+ */
+_nodiscard auto rayPolygon(glm::vec2 origin,
+                           glm::vec2 delta,
+                           glm::vec2 position,
+                           std::span<const glm::vec2> borders,
+                           glm::vec2 scale,
+                           float maxFraction,
+                           glm::vec2 &normal) noexcept -> float;
+
+/// @brief Returns true if @param point is inside the outline @param borders scaled by @param scale and placed at @param position (even-odd rule).
+_nodiscard auto pointInPolygon(glm::vec2 point, glm::vec2 position, std::span<const glm::vec2> borders, glm::vec2 scale) noexcept -> bool;
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_QUERY_H
@@ -0,0 +1,238 @@
+#include "src/physics/shapepool.h"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <ranges>
+
+#include "src/physics/pairset.h"
+
+namespace
+{
+
+/// @brief Hashes the content of a shape, identical shapes give the same value.
+auto hashParts(const std::span<const Physics::ConvexPart> parts) -> uint64_t
+{
+    uint64_t hash = Physics::pairHash(parts.size());
+
+    const auto mix = [&hash](const std::span<const glm::vec2> points) -> void {
+        hash = Physics::pairHash(hash ^ points.size());
+        for (const auto &p : points) {
+            const uint64_t bits = static_cast<uint64_t>(std::bit_cast<uint32_t>(p.x)) << 32 | std::bit_cast<uint32_t>(p.y);
+            hash = Physics::pairHash(hash ^ bits);
+        }
+    };
+    for (const auto &part : parts) {
+        mix(part.borders);
+        mix(part.normals);
+    }
+
+    return hash;
+}
+
+/// @brief Tells the kind of a convex part, filling @param boxAxes for boxes.
+auto classify(const Physics::ConvexPart &part, const glm::vec2 min, const glm::vec2 max, std::array<uint8_t, 2> &boxAxes) -> Physics::ShapeKind
+{
+    constexpr float tolerance = 1e-4f;
+
+    // Two perpendicular axes, a normal and its opposite giving the same one.
+    std::array<size_t, 2> axes{};
+    size_t axesCount = 0;
+    for (size_t i = 0; i < part.normals.size(); ++i) {
+        const bool known = (axesCount > 0 && std::abs(std::abs(glm::dot(part.normals[i], part.normals[axes[0]])) - 1.f) <= tolerance)
+                           || (axesCount > 1 && std::abs(std::abs(glm::dot(part.normals[i], part.normals[axes[1]])) - 1.f) <= tolerance);
+        if (known) {
+            continue;
+        }
+        if (axesCount == 2) {
+            return Physics::ShapeKind::Convex;
+        }
+        axes[axesCount++] = i;
+    }
+    if (axesCount != 2 || std::abs(glm::dot(part.normals[axes[0]], part.normals[axes[1]])) > tolerance) {
+        return Physics::ShapeKind::Convex;
+    }
+
+    // Four distinct corners, outlines may repeat their first point.
+    size_t corners = 0;
+    for (size_t i = 0; i < part.borders.size(); ++i) {
+        const auto &p = part.borders[i];
+        const bool repeated = std::ranges::any_of(part.borders.begin(), part.borders.begin() + static_cast<std::ptrdiff_t>(i), [&p](const glm::vec2 &q) -> bool {
+            return glm::length(p - q) <= tolerance;
+        });
+        corners += repeated ? 0 : 1;
+    }
+    if (corners != 4) {
+        return Physics::ShapeKind::Convex;
+    }
+
+    const auto &first = part.normals[axes[0]];
+    if (std::abs(first.x) < 1.f - tolerance && std::abs(first.y) < 1.f - tolerance) {
+        return Physics::ShapeKind::OrientedBox;
+    }
+
+    const auto onCorner = [min, max](const glm::vec2 &p) -> bool {
+        return (std::abs(p.x - min.x) <= tolerance || std::abs(p.x - max.x) <= tolerance)
+               && (std::abs(p.y - min.y) <= tolerance || std::abs(p.y - max.y) <= tolerance);
+    };
+    if (!std::ranges::all_of(part.borders, onCorner)) {
+        return Physics::ShapeKind::Convex;
+    }
+
+    const bool firstIsX = std::abs(first.x) > std::abs(first.y);
+    boxAxes = {static_cast<uint8_t>(firstIsX ? axes[0] : axes[1]), static_cast<uint8_t>(firstIsX ? axes[1] : axes[0])};
+
+    return Physics::ShapeKind::Box;
+}
+
+} // namespace
+
+namespace Physics
+{
+
+auto ShapePool::intern(const std::span<const glm::vec2> borders, const std::span<const glm::vec2> normals) -> uint32_t
+{
+    const std::array part{ConvexPart{
+        .borders = {borders.begin(), borders.end()},
+        .normals = {normals.begin(), normals.end()},
+    }};
+
+    return intern(part);
+}
+
+auto ShapePool::intern(const std::span<const ConvexPart> parts) -> uint32_t
+{
+    const auto hash = hashParts(parts);
+
+    const auto [first, last] = m_lookup.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        const auto id = it->second;
+        const auto sameParts = std::ranges::equal(std::views::iota(0u, partCount(id)), parts, [this, id](const uint32_t k, const ConvexPart &other) -> bool {
+            const auto existing = part(id, k);
+            return std::ranges::equal(existing.borders, other.borders) && std::ranges::equal(existing.normals, other.normals);
+        });
+        if (sameParts) {
+            return id;
+        }
+    }
+
+    const auto id = static_cast<uint32_t>(m_shapes.size());
+    Entry entry{
+        .whole = {
+            .firstBorder = static_cast<uint32_t>(m_borders.size()),
+            .firstNormal = static_cast<uint32_t>(m_normals.size()),
+            .min = glm::vec2{std::numeric_limits<float>::max()},
+            .max = glm::vec2{std::numeric_limits<float>::lowest()},
+        },
+        .firstPart = static_cast<uint32_t>(m_parts.size()),
+        .partCount = static_cast<uint32_t>(parts.size()),
+    };
+
+    for (const auto &part : parts) {
+        Range range{
+            .firstBorder = static_cast<uint32_t>(m_borders.size()),
+            .borderCount = static_cast<uint32_t>(part.borders.size()),
+            .firstNormal = static_cast<uint32_t>(m_normals.size()),
+            .normalCount = static_cast<uint32_t>(part.normals.size()),
+            .min = glm::vec2{std::numeric_limits<float>::max()},
+            .max = glm::vec2{std::numeric_limits<float>::lowest()},
+        };
+        for (const auto &p : part.borders) {
+            range.min = glm::min(range.min, p);
+            range.max = glm::max(range.max, p);
+        }
+        range.kind = classify(part, range.min, range.max, range.boxAxes);
+        m_parts.push_back(range);
+
+        m_borders.append_range(part.borders);
+        m_normals.append_range(part.normals);
+        for (const auto &p : part.borders) {
+            m_xs.push_back(p.x);
+            m_ys.push_back(p.y);
+        }
+
+        entry.whole.borderCount += static_cast<uint32_t>(part.borders.size());
+        entry.whole.normalCount += static_cast<uint32_t>(part.normals.size());
+        entry.whole.min = glm::min(entry.whole.min, range.min);
+        entry.whole.max = glm::max(entry.whole.max, range.max);
+    }
+
+    if (parts.size() == 1) {
+        entry.whole.kind = m_parts.back().kind;
+        entry.whole.boxAxes = m_parts.back().boxAxes;
+    } else {
+        entry.whole.kind = ShapeKind::Compound;
+    }
+    if (parts.empty()) {
+        entry.whole.min = entry.whole.max = glm::vec2{};
+    }
+
+    m_shapes.push_back(entry);
+    m_lookup.emplace(hash, id);
+
+    return id;
+}
+
+auto ShapePool::view(const Range &range) const noexcept -> Shape
+{
+    return Shape{
+        .borders = std::span(m_borders).subspan(range.firstBorder, range.borderCount),
+        .normals = std::span(m_normals).subspan(range.firstNormal, range.normalCount),
+        .xs = std::span(m_xs).subspan(range.firstBorder, range.borderCount),
+        .ys = std::span(m_ys).subspan(range.firstBorder, range.borderCount),
+        .min = range.min,
+        .max = range.max,
+        .kind = range.kind,
+        .boxAxes = range.boxAxes,
+    };
+}
+
+auto ShapePool::shape(const uint32_t id) const noexcept -> Shape
+{
+    assert(id < m_shapes.size());
+
+    return view(m_shapes[id].whole);
+}
+
+auto ShapePool::part(const uint32_t id, const uint32_t index) const noexcept -> Shape
+{
+    assert(id < m_shapes.size());
+    assert(index < m_shapes[id].partCount);
+
+    return view(m_parts[m_shapes[id].firstPart + index]);
+}
+
+auto ShapePool::bytes(const uint32_t id) const noexcept -> size_t
+{
+    assert(id < m_shapes.size());
+
+    const auto &entry = m_shapes[id];
+    return entry.whole.borderCount * (sizeof(glm::vec2) + 2 * sizeof(float)) + entry.whole.normalCount * sizeof(glm::vec2)
+           + entry.partCount * sizeof(Range);
+}
+
+auto ShapePool::memoryBytes() const noexcept -> size_t
+{
+    return m_shapes.capacity() * sizeof(Entry) + m_parts.capacity() * sizeof(Range)
+           + (m_borders.capacity() + m_normals.capacity()) * sizeof(glm::vec2) + (m_xs.capacity() + m_ys.capacity()) * sizeof(float)
+           + m_lookup.size() * (sizeof(uint64_t) + sizeof(uint32_t) + sizeof(void *)) + m_lookup.bucket_count() * sizeof(void *);
+}
+
+void ShapePool::clear()
+{
+    m_shapes.clear();
+    m_parts.clear();
+    m_borders.clear();
+    m_normals.clear();
+    m_xs.clear();
+    m_ys.clear();
+    m_lookup.clear();
+}
+
+} // namespace Physics
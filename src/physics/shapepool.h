@@ -0,0 +1,148 @@
+#ifndef JP_PHYSICS_SHAPEPOOL_H
+#define JP_PHYSICS_SHAPEPOOL_H
+
+#include <glm/vec2.hpp>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "src/keywords.h"
+#include "src/physics/enums.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Outline stored in a @ref ShapePool, relative to the entity position and before scaling.
+ * Either a convex part of a shape, or the points and normals of all the parts of a shape together.
+ */
+struct Shape
+{
+    /// @brief Points of the outline.
+    std::span<const glm::vec2> borders{};
+    /// @brief Normals of the outline, one per SAT axis.
+    std::span<const glm::vec2> normals{};
+    /// @brief X coordinates of @var borders, split for the vectorized projection.
+    std::span<const float> xs{};
+    /// @brief Y coordinates of @var borders, split for the vectorized projection.
+    std::span<const float> ys{};
+    /// @brief Lower corner of the bounds of @var borders.
+    glm::vec2 min{};
+    /// @brief Upper corner of the bounds of @var borders.
+    glm::vec2 max{};
+    /// @brief Kind of the outline, selects the narrow phase kernel.
+    ShapeKind kind = ShapeKind::Convex;
+    /// @brief For boxes, index in @var normals of the X axis and of the Y axis.
+    std::array<uint8_t, 2> boxAxes{};
+};
+
+/**
+ * @brief Convex polygon added to a @ref ShapePool, a shape being made of one or several of them.
+ */
+struct ConvexPart
+{
+    /// @brief Points of the polygon.
+    std::vector<glm::vec2> borders{};
+    /// @brief Normals of the polygon's borders, parallel ones being given once.
+    std::vector<glm::vec2> normals{};
+
+    /// @brief Parts are compared by value when interned.
+    auto operator==(const ConvexPart &) const -> bool = default;
+};
+
+/**
+ * @brief Immutable collision shapes shared by the entities.
+ *
+ * Shapes are interned: adding an outline that is already in the pool returns the existing id, so that every tile
+ * of a resource refers to the same data. Outlines are stored back to back in flat arrays, a shape being a range
+ * of each of them. Entities only keep the shape id and a scale (Entity::PhysicsBounds).
+ *
+ * A shape is a compound of convex parts, tested pair by pair by the narrow phase. The parts of a shape being stored
+ * next to each other, the whole shape is a range of the arrays as well.
+ *
+ * @note The spans returned by @fn shape and @fn part are invalidated by @fn intern, the pool is filled at load only.
+ */
+class ShapePool
+{
+public:
+    /// @brief Adds a convex shape, or finds an identical one, and returns its id.
+    auto intern(std::span<const glm::vec2> borders, std::span<const glm::vec2> normals) -> uint32_t;
+    /// @brief Adds a shape made of @param parts, or finds an identical one, and returns its id.
+    auto intern(std::span<const ConvexPart> parts) -> uint32_t;
+
+    /// @brief Returns the points and normals of every part of shape @param id together.
+    _nodiscard auto shape(uint32_t id) const noexcept -> Shape;
+    /// @brief Returns the kind of shape @param id, Compound when it has several parts.
+    _nodiscard auto kind(uint32_t id) const noexcept -> ShapeKind { return m_shapes[id].whole.kind; }
+    /// @brief Returns the number of convex parts of shape @param id.
+    _nodiscard auto partCount(uint32_t id) const noexcept -> uint32_t { return m_shapes[id].partCount; }
+    /// @brief Returns convex part @param index of shape @param id.
+    _nodiscard auto part(uint32_t id, uint32_t index) const noexcept -> Shape;
+    /// @brief Returns the number of distinct shapes.
+    _nodiscard auto size() const noexcept -> size_t { return m_shapes.size(); }
+    /// @brief Returns the bytes used by the data of shape @param id alone.
+    _nodiscard auto bytes(uint32_t id) const noexcept -> size_t;
+    /// @brief Returns the bytes allocated by the pool.
+    _nodiscard auto memoryBytes() const noexcept -> size_t;
+
+    /// @brief Removes every shape.
+    void clear();
+
+private:
+    /// @brief Position of an outline in the flat arrays.
+    struct Range
+    {
+        /// @brief Index of the first point in @var m_borders, @var m_xs and @var m_ys.
+        uint32_t firstBorder = 0;
+        /// @brief Number of points.
+        uint32_t borderCount = 0;
+        /// @brief Index of the first normal in @var m_normals.
+        uint32_t firstNormal = 0;
+        /// @brief Number of normals.
+        uint32_t normalCount = 0;
+        /// @brief Lower corner of the bounds of the points.
+        glm::vec2 min{};
+        /// @brief Upper corner of the bounds of the points.
+        glm::vec2 max{};
+        /// @brief Kind of the outline.
+        ShapeKind kind = ShapeKind::Convex;
+        /// @brief For boxes, index of the X and Y axes in the normals.
+        std::array<uint8_t, 2> boxAxes{};
+    };
+
+    /// @brief Parts of a shape.
+    struct Entry
+    {
+        /// @brief Every part together.
+        Range whole{};
+        /// @brief Index of the first part in @var m_parts.
+        uint32_t firstPart = 0;
+        /// @brief Number of parts.
+        uint32_t partCount = 0;
+    };
+
+    /// @brief Returns the view of @param range.
+    _nodiscard auto view(const Range &range) const noexcept -> Shape;
+
+    /// @brief Shapes, indexed by id.
+    std::vector<Entry> m_shapes{};
+    /// @brief Ranges of the parts of all the shapes.
+    std::vector<Range> m_parts{};
+    /// @brief Points of all the shapes.
+    std::vector<glm::vec2> m_borders{};
+    /// @brief Normals of all the shapes.
+    std::vector<glm::vec2> m_normals{};
+    /// @brief X coordinates of @var m_borders.
+    std::vector<float> m_xs{};
+    /// @brief Y coordinates of @var m_borders.
+    std::vector<float> m_ys{};
+    /// @brief Ids of the shapes by hash of their content, to find duplicates.
+    std::unordered_multimap<uint64_t, uint32_t> m_lookup{};
+};
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_SHAPEPOOL_H
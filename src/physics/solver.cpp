@@ -0,0 +1,128 @@
+#include "src/physics/solver.h"
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+
+#include <ctrack.hpp>
+
+#include "src/physics/pairset.h"
+
+namespace Physics
+{
+
+void Solver::reset()
+{
+    m_manifolds.clear();
+    m_previous.clear();
+    m_cursor = 0;
+    m_warmStarted = 0;
+}
+
+void Solver::begin()
+{
+    std::swap(m_manifolds, m_previous);
+    m_manifolds.clear();
+    m_cursor = 0;
+    m_warmStarted = 0;
+}
+
+void Solver::add(const int a, const int b, const Entity::CollisionInfo &info)
+{
+    auto &manifold = m_manifolds.emplace_back(Manifold{
+        .a = a,
+        .b = b,
+        .normal = info.normal,
+        .depth = info.depth,
+    });
+
+    // Both lists are sorted by pair, a merge finds the previous manifold of the pair.
+    const auto key = pairKey(a, b);
+    while (m_cursor < m_previous.size() && pairKey(m_previous[m_cursor].a, m_previous[m_cursor].b) < key) {
+        ++m_cursor;
+    }
+    if (m_cursor < m_previous.size() && pairKey(m_previous[m_cursor].a, m_previous[m_cursor].b) == key) {
+        manifold.normalImpulse = m_previous[m_cursor].normalImpulse;
+        manifold.timeStep = m_previous[m_cursor].timeStep;
+        ++m_warmStarted;
+    }
+}
+
+void Solver::solve(Entities &entities, const double timeDelta)
+{
+    CTRACK;
+
+    const auto setups = entities.column<Entity::PhysicsSetup>();
+    const auto cStates = entities.column<Entity::PhysicsCartesianState>();
+    const auto objStates = entities.column<Entity::PhysicsObjectState>();
+
+    // Only the entities affected by collisions (canCollide) and not fixed respond to a contact.
+    const auto invMass = [&setups](const int i) -> float {
+        return setups[i].canCollide && setups[i].isNotFixed ? 1.f / setups[i].mass : 0.f;
+    };
+    // Entities far from the player are integrated over several steps at once.
+    const auto steps = [&objStates](const int i) -> float { return static_cast<float>(std::max<uint16_t>(objStates[i].lodSteps, 1)); };
+
+    /* Prepare and warm start */
+    for (auto &manifold : m_manifolds) {
+        manifold.invMassA = invMass(manifold.a);
+        manifold.invMassB = invMass(manifold.b);
+
+        const float massSum = manifold.invMassA + manifold.invMassB;
+        if (massSum == 0.f) {
+            manifold.normalImpulse = 0.f;
+            continue;
+        }
+        manifold.normalMass = 1.f / massSum;
+
+        // The longest step moves the pair the most, a shorter one would push it apart too fast.
+        const float stepsA = manifold.invMassA != 0.f ? steps(manifold.a) : 1.f;
+        const float stepsB = manifold.invMassB != 0.f ? steps(manifold.b) : 1.f;
+        const float dt = static_cast<float>(timeDelta) * std::max(stepsA, stepsB);
+
+        // Impulses hold the pair over a whole step, they grow with it.
+        if (manifold.timeStep > 0.f) {
+            manifold.normalImpulse *= dt / manifold.timeStep;
+        }
+        manifold.timeStep = dt;
+
+        auto &vA = cStates[manifold.a].velocity;
+        auto &vB = cStates[manifold.b].velocity;
+
+        // Bounce only on impacts, and push penetrating entities apart over a few steps.
+        const float approach = glm::dot(vB - vA, manifold.normal);
+        const float e = std::clamp(std::min(setups[manifold.a].elasticity, setups[manifold.b].elasticity), 0.f, 1.f);
+        const float restitution = approach < -Config::restitutionThreshold ? -e * approach : 0.f;
+        const float recovery = Config::contactBaumgarte / dt * std::max(manifold.depth - Config::contactSlop, 0.f);
+        manifold.velocityBias = std::max(restitution, recovery);
+
+        const auto impulse = manifold.normalImpulse * manifold.normal;
+        vA -= manifold.invMassA * impulse;
+        vB += manifold.invMassB * impulse;
+    }
+
+    /* Iterate */
+    for (int iteration = 0; iteration < m_iterations; ++iteration) {
+        for (auto &manifold : m_manifolds) {
+            if (manifold.normalMass == 0.f) {
+                continue;
+            }
+
+            auto &vA = cStates[manifold.a].velocity;
+            auto &vB = cStates[manifold.b].velocity;
+
+            const float normalVelocity = glm::dot(vB - vA, manifold.normal);
+            const float lambda = manifold.normalMass * (manifold.velocityBias - normalVelocity);
+
+            // The accumulated impulse may only push, clamp it rather than the increment.
+            const float accumulated = std::max(manifold.normalImpulse + lambda, 0.f);
+            const auto impulse = (accumulated - manifold.normalImpulse) * manifold.normal;
+            manifold.normalImpulse = accumulated;
+
+            vA -= manifold.invMassA * impulse;
+            vB += manifold.invMassB * impulse;
+        }
+    }
+}
+
+} // namespace Physics
@@ -0,0 +1,99 @@
+#ifndef JP_PHYSICS_SOLVER_H
+#define JP_PHYSICS_SOLVER_H
+
+#include <glm/vec2.hpp>
+
+#include <span>
+#include <vector>
+
+#include "src/config.h"
+#include "src/entity/components.h"
+#include "src/entity/vector.h"
+#include "src/keywords.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Contact constraint between two entities, kept from one step to the next.
+ */
+struct Manifold
+{
+    /// @brief Lowest entity index of the pair.
+    int a = 0;
+    /// @brief Highest entity index of the pair.
+    int b = 0;
+    /// @brief Contact normal, from a to b.
+    glm::vec2 normal{};
+    /// @brief Penetration depth.
+    float depth = 0.f;
+    /// @brief Impulse accumulated along the normal, reapplied at the beginning of the next step.
+    float normalImpulse = 0.f;
+    /// @brief Inverse of the inverse masses sum, 0 when neither entity responds to the contact.
+    float normalMass = 0.f;
+    /// @brief Separating velocity the solver aims for (restitution, penetration recovery).
+    float velocityBias = 0.f;
+    /// @brief Inverse mass of a, 0 when it does not respond to the contact.
+    float invMassA = 0.f;
+    /// @brief Inverse mass of b, 0 when it does not respond to the contact.
+    float invMassB = 0.f;
+    /// @brief Time step the pair was solved with, the one of the previous step until @fn Solver::solve.
+    float timeStep = 0.f;
+};
+
+/**
+ * @brief Sequential impulse contact solver.
+ *
+ * The contacts of a step are added in pair order, each one picking the impulse accumulated by the same
+ * pair during the previous step up (warm starting). @fn solve then iterates over the manifolds, clamping
+ * the accumulated impulses, and leaves position correction to a velocity bias.
+ */
+class Solver
+{
+public:
+    /// @brief Entity storage the solver works on.
+    using Entities = Entity::VectorTypes<Entity::PhysicsEntity>;
+
+    /// @brief Drops the manifolds of the previous step, called when the scene changes.
+    void reset();
+
+    /// @brief Starts a new step, the manifolds of the current one become the warm starting data.
+    void begin();
+    /**
+     * @brief Adds the contact between @param a and @param b, a being the lowest index.
+     * @note Contacts must be added sorted by pair (Physics::pairKey).
+     */
+    void add(int a, int b, const Entity::CollisionInfo &info);
+    /**
+     * @brief Solves the manifolds added since @fn begin, updating the entities' velocities.
+     * @param timeDelta Duration of the step, each pair using the longest time step its entities are integrated with
+     * (Entity::PhysicsObjectState::lodSteps).
+     */
+    void solve(Entities &entities, double timeDelta);
+
+    /// @brief Sets the number of iterations made over the manifolds.
+    void setIterations(const int iterations) { m_iterations = iterations; }
+    /// @brief Returns the number of iterations made over the manifolds.
+    _nodiscard auto iterations() const -> int { return m_iterations; }
+
+    /// @brief Manifolds of the current step.
+    _nodiscard auto manifolds() const -> std::span<const Manifold> { return m_manifolds; }
+    /// @brief Manifolds of the current step that existed in the previous one.
+    _nodiscard auto warmStarted() const -> size_t { return m_warmStarted; }
+
+private:
+    /// @brief Iterations made over the manifolds.
+    int m_iterations = Config::solverIterations;
+    /// @brief Manifolds of the current step, in pair order.
+    std::vector<Manifold> m_manifolds{};
+    /// @brief Manifolds of the previous step, in pair order.
+    std::vector<Manifold> m_previous{};
+    /// @brief Position in @var m_previous of the last matching search.
+    size_t m_cursor = 0;
+    /// @brief Manifolds warm started during the current step.
+    size_t m_warmStarted = 0;
+};
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_SOLVER_H
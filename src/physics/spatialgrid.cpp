@@ -0,0 +1,142 @@
+#include "src/physics/spatialgrid.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+#include <ctrack.hpp>
+
+
+namespace Physics
+{
+
+SpatialGrid::SpatialGrid(const float cellSize, const uint32_t bucketCount)
+    : m_cellSize(cellSize)
+    , m_bucketMask(std::bit_ceil(bucketCount) - 1)
+{
+    assert(cellSize > 0.f);
+    assert(bucketCount > 0);
+
+    m_staticBuckets.resize(m_bucketMask + 1);
+    m_dynamicBuckets.resize(m_bucketMask + 1);
+}
+
+void SpatialGrid::setCellSize(const float cellSize)
+{
+    assert(cellSize > 0.f);
+
+    m_cellSize = cellSize;
+    reset();
+}
+
+void SpatialGrid::reset()
+{
+    for (auto &bucket : m_staticBuckets) {
+        bucket.clear();
+    }
+    for (const auto bucket : m_touchedBuckets) {
+        m_dynamicBuckets[bucket].clear();
+    }
+
+    m_touchedBuckets.clear();
+    m_dynamics.clear();
+    m_pairs.clear();
+    m_builtFor = -1;
+}
+
+auto SpatialGrid::bucketOf(const int32_t cx, const int32_t cy) const -> uint32_t
+{
+    // Two large primes, usual spatial hashing of integer coordinates.
+    const auto h = static_cast<uint32_t>(cx) * 73856093u ^ static_cast<uint32_t>(cy) * 19349663u;
+    return h & m_bucketMask;
+}
+
+template<typename F>
+void SpatialGrid::forEachBucket(const Entity::AABB &bounds, F &&fn) const
+{
+    const auto x0 = static_cast<int32_t>(std::floor(bounds.min.x / m_cellSize));
+    const auto y0 = static_cast<int32_t>(std::floor(bounds.min.y / m_cellSize));
+    const auto x1 = static_cast<int32_t>(std::floor(bounds.max.x / m_cellSize));
+    const auto y1 = static_cast<int32_t>(std::floor(bounds.max.y / m_cellSize));
+
+    for (int32_t cy = y0; cy <= y1; ++cy) {
+        for (int32_t cx = x0; cx <= x1; ++cx) {
+            fn(bucketOf(cx, cy));
+        }
+    }
+}
+
+void SpatialGrid::update(const Entities &entities)
+{
+    CTRACK;
+
+    const auto size = entities.size();
+    const auto bounds = entities.column<Entity::WorldAABB>();
+
+    /* Insert fixed entities once */
+    if (m_builtFor != size) {
+        reset();
+
+        int i = 0;
+        for (const auto &[setup] : entities.range<Entity::PhysicsSetup>()) {
+            if (setup.isNotFixed) {
+                m_dynamics.push_back(i);
+            } else {
+                forEachBucket(bounds[i].bounds, [this, i](const uint32_t bucket) -> void { m_staticBuckets[bucket].push_back(i); });
+            }
+            ++i;
+        }
+
+        m_builtFor = size;
+    }
+
+    /* Re-insert moving entities */ {
+        for (const auto bucket : m_touchedBuckets) {
+            m_dynamicBuckets[bucket].clear();
+        }
+        m_touchedBuckets.clear();
+
+        for (const int d : m_dynamics) {
+            forEachBucket(bounds[d].bounds, [this, d](const uint32_t bucket) -> void {
+                auto &content = m_dynamicBuckets[bucket];
+                if (content.empty()) {
+                    m_touchedBuckets.push_back(bucket);
+                }
+                content.push_back(d);
+            });
+        }
+    }
+
+    /* Collect pairs sharing a cell */ {
+        m_pairs.clear();
+
+        const auto layers = entities.column<Entity::CollisionLayers>();
+        const auto tryPair = [this, bounds, layers](const int a, const int b) -> void {
+            if (a != b && layers[a].accepts(layers[b]) && bounds[a].bounds.intersects(bounds[b].bounds)) {
+                m_pairs.emplace_back(std::min(a, b), std::max(a, b));
+            }
+        };
+
+        for (const int d : m_dynamics) {
+            forEachBucket(bounds[d].bounds, [this, d, &tryPair](const uint32_t bucket) -> void {
+                for (const int other : m_staticBuckets[bucket]) {
+                    tryPair(d, other);
+                }
+                // Moving pairs are only emitted from their lowest index, the other side would find it again.
+                for (const int other : m_dynamicBuckets[bucket]) {
+                    if (d < other) {
+                        tryPair(d, other);
+                    }
+                }
+            });
+        }
+
+        // Entities covering several cells shared with the same neighbour are reported more than once.
+        std::ranges::sort(m_pairs);
+        const auto [first, last] = std::ranges::unique(m_pairs);
+        m_pairs.erase(first, last);
+    }
+}
+
+} // namespace Physics
@@ -0,0 +1,85 @@
+#ifndef JP_PHYSICS_SPATIALGRID_H
+#define JP_PHYSICS_SPATIALGRID_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "src/config.h"
+#include "src/entity/components.h"
+#include "src/entity/vector.h"
+#include "src/keywords.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Uniform spatial hash grid broad phase.
+ *
+ * Entities are bucketed by the cells covered by their world-space AABB.
+ * The grid's origin is the world's origin, so cells line up with the map's chunks.
+ * Fixed entities are inserted once, moving ones are re-inserted on every @fn update.
+ * Only pairs sharing a cell (and whose bounds overlap) are reported, a fixed entity
+ * is never paired with another fixed one.
+ */
+class SpatialGrid
+{
+public:
+    /// @brief Entity storage the broad phase works on.
+    using Entities = Entity::VectorTypes<Entity::PhysicsEntity>;
+
+    /// @brief Builds an empty grid.
+    explicit SpatialGrid(float cellSize = Config::gridCellSize, uint32_t bucketCount = Config::gridBucketCount);
+
+    /**
+     * @brief Changes the size of the cells.
+     * @note Forces a rebuild of the fixed entities on next @fn update.
+     */
+    void setCellSize(float cellSize);
+    /// @brief Size of a cell's side, in world units.
+    _nodiscard auto cellSize() const -> float { return m_cellSize; }
+
+    /**
+     * @brief Re-inserts moving entities and collects the pairs sharing a cell.
+     * @note Fixed entities are (re)inserted only when the number of entities changed.
+     * @note Entity::WorldAABB must be up to date.
+     */
+    void update(const Entities &entities);
+
+    /// @brief Pairs (lower index first) sharing at least one cell, as of the last @fn update.
+    _nodiscard auto pairs() const -> const std::vector<std::pair<int, int>> & { return m_pairs; }
+
+    /// @brief Drops every inserted entity, next @fn update performs a full rebuild.
+    void reset();
+
+private:
+    /// @brief Size of a cell's side.
+    float m_cellSize = Config::gridCellSize;
+    /// @brief Mask applied to cell hashes, bucket count is a power of two.
+    uint32_t m_bucketMask = 0;
+    /// @brief Number of entities the fixed buckets were built for.
+    size_t m_builtFor = -1;
+
+    /// @brief Buckets of fixed entities, built once.
+    std::vector<std::vector<int>> m_staticBuckets{};
+    /// @brief Buckets of moving entities, refilled every update.
+    std::vector<std::vector<int>> m_dynamicBuckets{};
+    /// @brief Buckets of @var m_dynamicBuckets filled during the current update.
+    std::vector<uint32_t> m_touchedBuckets{};
+
+    /// @brief Indices of the moving entities.
+    std::vector<int> m_dynamics{};
+    /// @brief Pairs found by the last update.
+    std::vector<std::pair<int, int>> m_pairs{};
+
+    /// @brief Returns the bucket a cell falls into.
+    _nodiscard auto bucketOf(int32_t cx, int32_t cy) const -> uint32_t;
+
+    /// @brief Calls @param fn with the bucket of every cell covered by @param bounds.
+    template<typename F>
+    void forEachBucket(const Entity::AABB &bounds, F &&fn) const;
+};
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_SPATIALGRID_H
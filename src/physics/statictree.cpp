@@ -0,0 +1,103 @@
+#include "src/physics/statictree.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include <ctrack.hpp>
+
+#include "src/physics/entity.h"
+
+namespace Physics
+{
+
+void StaticTree::clear()
+{
+    m_nodes.clear();
+    m_items.clear();
+    m_itemBounds.clear();
+    m_builtFor = 0;
+}
+
+void StaticTree::build(const Entities &entities)
+{
+    CTRACK;
+
+    clear();
+
+    int i = 0;
+    for (const auto &[setup, cState, boundingBox] : entities.range<Entity::PhysicsSetup, Entity::PhysicsCartesianState, Entity::AABB>()) {
+        if (!setup.isNotFixed) {
+            m_items.push_back(i);
+            m_itemBounds.push_back(worldBounds(cState, boundingBox));
+        }
+        ++i;
+    }
+
+    m_builtFor = entities.size();
+
+    if (m_items.empty()) {
+        return;
+    }
+
+    // Median splits leave at least 2 items per leaf, so there are less nodes than items.
+    m_nodes.reserve(m_items.size());
+    m_nodes.emplace_back();
+    buildNode(0, 0, static_cast<int32_t>(m_items.size()), 0);
+}
+
+void StaticTree::buildNode(const int32_t nodeIndex, const int32_t begin, const int32_t end, const int32_t depth)
+{
+    assert(begin < end);
+
+    Entity::AABB bounds = m_itemBounds[begin];
+    for (int32_t i = begin + 1; i < end; ++i) {
+        bounds.min = glm::min(bounds.min, m_itemBounds[i].min);
+        bounds.max = glm::max(bounds.max, m_itemBounds[i].max);
+    }
+    m_nodes[nodeIndex].bounds = bounds;
+
+    if (end - begin <= leafSize || depth + 1 >= maxDepth) {
+        m_nodes[nodeIndex].first = begin;
+        m_nodes[nodeIndex].count = end - begin;
+        return;
+    }
+
+    // Median split along the longest axis of the node.
+    const auto extent = bounds.max - bounds.min;
+    const int axis = extent.x >= extent.y ? 0 : 1;
+    const int32_t middle = begin + (end - begin) / 2;
+
+    /* Partition items & their bounds together */ {
+        std::vector<int32_t> order(static_cast<size_t>(end - begin));
+        for (int32_t i = 0; i < end - begin; ++i) {
+            order[i] = begin + i;
+        }
+
+        std::ranges::nth_element(order, order.begin() + (middle - begin), [this, axis](const int32_t a, const int32_t b) -> bool {
+            return m_itemBounds[a].min[axis] + m_itemBounds[a].max[axis] < m_itemBounds[b].min[axis] + m_itemBounds[b].max[axis];
+        });
+
+        std::vector<int> items{};
+        std::vector<Entity::AABB> itemBounds{};
+        items.reserve(order.size());
+        itemBounds.reserve(order.size());
+        for (const auto o : order) {
+            items.push_back(m_items[o]);
+            itemBounds.push_back(m_itemBounds[o]);
+        }
+
+        std::ranges::copy(items, m_items.begin() + begin);
+        std::ranges::copy(itemBounds, m_itemBounds.begin() + begin);
+    }
+
+    const auto left = static_cast<int32_t>(m_nodes.size());
+    m_nodes.emplace_back();
+    m_nodes.emplace_back();
+    m_nodes[nodeIndex].first = left;
+    m_nodes[nodeIndex].count = 0;
+
+    buildNode(left, begin, middle, depth + 1);
+    buildNode(left + 1, middle, end, depth + 1);
+}
+
+} // namespace Physics
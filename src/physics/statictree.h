@@ -0,0 +1,143 @@
+#ifndef JP_PHYSICS_STATICTREE_H
+#define JP_PHYSICS_STATICTREE_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "src/entity/components.h"
+#include "src/entity/vector.h"
+#include "src/keywords.h"
+#include "src/physics/query.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Bounding volume hierarchy over the fixed entities of a scene.
+ *
+ * Built once when the map is loaded, fixed entities never move afterwards.
+ * Moving entities query it to find the fixed ones they may touch, so that
+ * fixed/fixed pairs are never generated.
+ */
+class StaticTree
+{
+public:
+    /// @brief Entity storage the tree is built from.
+    using Entities = Entity::VectorTypes<Entity::PhysicsEntity>;
+
+    /// @brief Maximum number of entities stored in a leaf.
+    static constexpr int32_t leafSize = 4;
+    /// @brief Maximum depth of the tree, bounds the query stack.
+    static constexpr int32_t maxDepth = 64;
+
+    /// @brief Builds the tree over all the fixed entities (isNotFixed == false).
+    void build(const Entities &entities);
+    /// @brief Drops the tree's content.
+    void clear();
+
+    /// @brief Number of fixed entities stored in the tree.
+    _nodiscard auto size() const -> size_t { return m_items.size(); }
+    /// @brief Number of entities the tree was built for, fixed or not.
+    _nodiscard auto builtFor() const -> size_t { return m_builtFor; }
+
+    /// @brief Calls @param fn with the index of every fixed entity whose world AABB overlaps @param bounds.
+    template<typename F>
+    void query(const Entity::AABB &bounds, F &&fn) const
+    {
+        if (m_nodes.empty()) {
+            return;
+        }
+
+        std::array<int32_t, maxDepth * 2> stack{};
+        size_t top = 0;
+        stack[top++] = 0;
+
+        while (top > 0) {
+            const auto &node = m_nodes[stack[--top]];
+            if (!node.bounds.intersects(bounds)) {
+                continue;
+            }
+
+            if (node.count > 0) {
+                for (int32_t i = node.first; i < node.first + node.count; ++i) {
+                    if (m_itemBounds[i].intersects(bounds)) {
+                        fn(m_items[i]);
+                    }
+                }
+            } else {
+                stack[top++] = node.first;
+                stack[top++] = node.first + 1;
+            }
+        }
+    }
+
+    /**
+     * @brief Walks the fixed entities whose world AABB a segment crosses, closest subtrees first.
+     * @param fn Called with an entity index and the current max fraction, returns the new max fraction
+     * (the fraction of its hit, or the one it was given), shrinking the rest of the walk.
+     */
+    template<typename F>
+    void raycast(const glm::vec2 origin, const glm::vec2 delta, float maxFraction, F &&fn) const
+    {
+        if (m_nodes.empty()) {
+            return;
+        }
+
+        std::array<int32_t, maxDepth * 2> stack{};
+        size_t top = 0;
+        stack[top++] = 0;
+
+        while (top > 0) {
+            const auto &node = m_nodes[stack[--top]];
+            if (rayAABB(origin, delta, node.bounds, maxFraction) > maxFraction) {
+                continue;
+            }
+
+            if (node.count > 0) {
+                for (int32_t i = node.first; i < node.first + node.count; ++i) {
+                    if (rayAABB(origin, delta, m_itemBounds[i], maxFraction) <= maxFraction) {
+                        maxFraction = fn(m_items[i], maxFraction);
+                    }
+                }
+                continue;
+            }
+
+            // Push the farthest child first, so that the closest one may shrink the segment before it is visited.
+            const auto near = rayAABB(origin, delta, m_nodes[node.first].bounds, maxFraction);
+            const auto far = rayAABB(origin, delta, m_nodes[node.first + 1].bounds, maxFraction);
+            stack[top++] = near <= far ? node.first + 1 : node.first;
+            stack[top++] = near <= far ? node.first : node.first + 1;
+        }
+    }
+
+private:
+    /**
+     * @brief Tree node, children of an inner node are stored next to each other.
+     */
+    struct Node
+    {
+        /// @brief Bounds enclosing the whole subtree.
+        Entity::AABB bounds{};
+        /// @brief First item for a leaf, left child for an inner node (right is first + 1).
+        int32_t first = -1;
+        /// @brief Number of items of a leaf, 0 for inner nodes.
+        int32_t count = 0;
+    };
+
+    /// @brief Nodes, the root is the first one.
+    std::vector<Node> m_nodes{};
+    /// @brief Entity indices, grouped by leaf.
+    std::vector<int> m_items{};
+    /// @brief World bounds of @var m_items, same order.
+    std::vector<Entity::AABB> m_itemBounds{};
+    /// @brief Number of entities in the scene when built.
+    size_t m_builtFor = 0;
+
+    /// @brief Recursively splits items [begin, end) into node @param nodeIndex.
+    void buildNode(int32_t nodeIndex, int32_t begin, int32_t end, int32_t depth);
+};
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_STATICTREE_H
@@ -0,0 +1,78 @@
+#ifndef JP_PHYSICS_STATS_H
+#define JP_PHYSICS_STATS_H
+
+#include <array>
+#include <cstddef>
+
+#include "src/physics/enums.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Counters describing the work done by the last simulation step.
+ * @note Reset at the beginning of every step, read them after Engine::compute returned.
+ */
+struct Stats
+{
+    /// @brief Number of entities in the simulated scene.
+    size_t entities = 0;
+    /// @brief Moving entities put to sleep, skipped by the integration.
+    size_t sleepingBodies = 0;
+    /// @brief Moving entities simulated this step.
+    size_t awakeBodies = 0;
+    /// @brief Pairs emitted by the broad phase and sent to the narrow phase.
+    size_t candidatePairs = 0;
+    /// @brief Candidate pairs rejected on their flags (canCollide, isNotFixed).
+    size_t filterRejected = 0;
+    /// @brief Candidate pairs rejected on their collision layers, only the brute force broad phase emits them.
+    size_t layerRejected = 0;
+    /// @brief Candidate pairs rejected because their world AABBs do not overlap.
+    size_t aabbRejected = 0;
+    /// @brief Candidate pairs rejected by the SAT test.
+    size_t satRejected = 0;
+    /// @brief Axes pairs were projected onto by the SAT test, cached ones included.
+    size_t satAxesTested = 0;
+    /// @brief Pairs reaching the SAT test, and looking their last separating axis up.
+    size_t axisCacheLookups = 0;
+    /// @brief Pairs rejected by their last separating axis alone, the hit rate is axisCacheHits / axisCacheLookups.
+    size_t axisCacheHits = 0;
+    /// @brief Calls of each narrow phase kernel, indexed by Physics::pairKernelIndex of the kinds of the parts tested.
+    std::array<size_t, convexShapeKinds * convexShapeKinds> kernelPairs{};
+    /// @brief Pairs for which the SAT test reported a contact.
+    size_t collidingPairs = 0;
+    /// @brief Contact events pushed during the step, see Physics::Engine::contactEvents, 0 until a consumer subscribed.
+    size_t contactEvents = 0;
+    /// @brief Contact events dropped during the step because the ring was full.
+    size_t contactEventsDropped = 0;
+    /// @brief Batches the narrow phase was split into, one per thread used.
+    size_t narrowPhaseThreads = 0;
+    /// @brief Contacts whose impulse was warm started from the previous step.
+    size_t warmStartedContacts = 0;
+    /// @brief Deepest penetration among the contacts, stays small once stacks are stable.
+    float maxPenetration = 0.f;
+    /// @brief Allocations made by the collision pair sets, zero once they reached their working size.
+    size_t pairCacheAllocations = 0;
+    /// @brief Time spent in the broad phase, in milliseconds.
+    double broadPhaseMs = 0.;
+    /// @brief Time spent testing the candidate pairs, SAT throughput is candidatePairs / narrowPhaseMs.
+    double narrowPhaseMs = 0.;
+    /// @brief Continuous entities whose motion was swept, having moved further than their extent.
+    size_t sweptBodies = 0;
+    /// @brief Moving entities in each level of detail tier, indexed by Physics::LodTier.
+    std::array<size_t, lodTierCount> lodBodies{};
+    /// @brief Moving entities skipped by the level of detail during the step.
+    size_t lodSkippedBodies = 0;
+    /// @brief Swept entities stopped at their time of impact.
+    size_t sweptHits = 0;
+    /// @brief Time spent in the contact solver, in milliseconds.
+    double solverMs = 0.;
+    /// @brief Time spent integrating forces and positions, in milliseconds.
+    double integrationMs = 0.;
+    /// @brief Time spent in the whole step, in milliseconds.
+    double tickMs = 0.;
+};
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_STATS_H
@@ -0,0 +1,113 @@
+#include "src/physics/sweepandprune.h"
+
+#include <algorithm>
+
+#include <ctrack.hpp>
+
+
+namespace Physics
+{
+
+void SweepAndPrune::reset()
+{
+    m_dynamics.clear();
+    m_statics.clear();
+    m_staticMinX.clear();
+    m_staticWidth = 0.f;
+    m_pairs.clear();
+    m_builtFor = -1;
+}
+
+void SweepAndPrune::update(const Entities &entities)
+{
+    CTRACK;
+
+    const auto size = entities.size();
+    const auto bounds = entities.column<Entity::WorldAABB>();
+    const auto layers = entities.column<Entity::CollisionLayers>();
+
+    /* Split and sort fixed entities once */
+    if (m_builtFor != size) {
+        reset();
+
+        int i = 0;
+        for (const auto &[setup] : entities.range<Entity::PhysicsSetup>()) {
+            if (setup.isNotFixed) {
+                m_dynamics.push_back(i);
+            } else {
+                m_statics.push_back(i);
+                m_staticWidth = std::max(m_staticWidth, bounds[i].bounds.max.x - bounds[i].bounds.min.x);
+            }
+            ++i;
+        }
+
+        std::ranges::sort(m_statics, {}, [bounds](const int s) -> float { return bounds[s].bounds.min.x; });
+        m_staticMinX.reserve(m_statics.size());
+        for (const int s : m_statics) {
+            m_staticMinX.push_back(bounds[s].bounds.min.x);
+        }
+
+        m_builtFor = size;
+    }
+
+    /* Insertion sort of the moving entities, close to O(n) as the order barely changes between two ticks. */ {
+        for (size_t i = 1; i < m_dynamics.size(); ++i) {
+            const int current = m_dynamics[i];
+            const float key = bounds[current].bounds.min.x;
+
+            size_t j = i;
+            while (j > 0 && bounds[m_dynamics[j - 1]].bounds.min.x > key) {
+                m_dynamics[j] = m_dynamics[j - 1];
+                --j;
+            }
+            m_dynamics[j] = current;
+        }
+    }
+
+    /* Sweep */ {
+        m_pairs.clear();
+
+        const auto tryPair = [this, layers](const int a, const int b, const Entity::AABB &aBounds, const Entity::AABB &bBounds) -> void {
+            if (bBounds.max.y < aBounds.min.y || bBounds.min.y > aBounds.max.y) {
+                return;
+            }
+            if (layers[a].accepts(layers[b])) {
+                m_pairs.emplace_back(std::min(a, b), std::max(a, b));
+            }
+        };
+
+        const auto dynamicCount = m_dynamics.size();
+        for (size_t i = 0; i < dynamicCount; ++i) {
+            const int a = m_dynamics[i];
+            const auto &aBounds = bounds[a].bounds;
+
+            // Every following moving entity starting before the end of this one overlaps on X.
+            for (size_t j = i + 1; j < dynamicCount; ++j) {
+                const int b = m_dynamics[j];
+                const auto &bBounds = bounds[b].bounds;
+
+                if (bBounds.min.x > aBounds.max.x) {
+                    break;
+                }
+                tryPair(a, b, aBounds, bBounds);
+            }
+
+            // Fixed entities starting further left than the widest one cannot reach this one.
+            const auto first = std::ranges::lower_bound(m_staticMinX, aBounds.min.x - m_staticWidth);
+            for (auto k = static_cast<size_t>(std::distance(m_staticMinX.begin(), first)); k < m_statics.size(); ++k) {
+                if (m_staticMinX[k] > aBounds.max.x) {
+                    break;
+                }
+
+                const int b = m_statics[k];
+                const auto &bBounds = bounds[b].bounds;
+                if (bBounds.max.x < aBounds.min.x) {
+                    continue;
+                }
+                tryPair(a, b, aBounds, bBounds);
+            }
+        }
+    }
+}
+
+} // namespace Physics
@@ -0,0 +1,59 @@
+#ifndef JP_PHYSICS_SWEEPANDPRUNE_H
+#define JP_PHYSICS_SWEEPANDPRUNE_H
+
+#include <utility>
+#include <vector>
+
+#include "src/entity/components.h"
+#include "src/entity/vector.h"
+#include "src/keywords.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Sweep-and-prune broad phase working along the X axis.
+ *
+ * Moving entities are kept sorted by the lower X bound of their world-space AABB (@ref Entity::WorldAABB).
+ * The order is kept between two calls to @fn update, so that the insertion
+ * sort only has to fix the few swaps caused by the motion of the last tick.
+ * Fixed entities never move, they are sorted once and each moving entity binary searches the ones it may overlap,
+ * so pairs of fixed entities are never generated.
+ */
+class SweepAndPrune
+{
+public:
+    /// @brief Entity storage the broad phase works on.
+    using Entities = Entity::VectorTypes<Entity::PhysicsEntity>;
+
+    /**
+     * @brief Re-sorts the entities and collects overlapping pairs.
+     * @note Entity::WorldAABB must be up to date.
+     * @note A full rebuild is done when the number of entities changed since the last call.
+     */
+    void update(const Entities &entities);
+
+    /// @brief Pairs (lower index first) whose world AABBs overlap, as of the last @fn update.
+    _nodiscard auto pairs() const -> const std::vector<std::pair<int, int>> & { return m_pairs; }
+
+    /// @brief Drops the cached order, next @fn update performs a full rebuild.
+    void reset();
+
+private:
+    /// @brief Number of entities the fixed list was built for.
+    size_t m_builtFor = -1;
+    /// @brief Indices of the moving entities, sorted by their world bounds' min.x.
+    std::vector<int> m_dynamics{};
+    /// @brief Indices of the fixed entities, sorted by their world bounds' min.x, built once.
+    std::vector<int> m_statics{};
+    /// @brief World bounds' min.x of each entity of @var m_statics.
+    std::vector<float> m_staticMinX{};
+    /// @brief Largest extent along X of the fixed entities, bounds the search of the ones a moving entity may overlap.
+    float m_staticWidth = 0.f;
+    /// @brief Overlapping pairs found by the last sweep.
+    std::vector<std::pair<int, int>> m_pairs{};
+};
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_SWEEPANDPRUNE_H
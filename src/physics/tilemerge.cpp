@@ -0,0 +1,200 @@
+#include "src/physics/tilemerge.h"
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include "src/config.h"
+#include "src/physics/entity.h"
+
+namespace
+{
+
+/**
+ * @brief Box candidate to the merge, world bounds and the entity giving its physical properties.
+ */
+struct Box
+{
+    /// @brief World bounds of the box.
+    Entity::AABB bounds{};
+    /// @brief Entity whose properties (setup, layers...) the merged collider takes.
+    int source = 0;
+    /// @brief Number of entities merged in the box.
+    int count = 1;
+};
+
+/// @brief Returns true if the entity's outline is exactly its bounding box.
+auto isBox(const Physics::ShapePool &shapes, const Entity::PhysicsBounds &bounds, const Entity::AABB &boundingBox) -> bool
+{
+    const auto borders = shapes.shape(bounds.shape).borders;
+    if (shapes.partCount(bounds.shape) != 1 || borders.size() < 4) {
+        return false;
+    }
+
+    const auto onCorner = [&boundingBox, &bounds](const glm::vec2 &point) -> bool {
+        const auto p = point * bounds.scale;
+        const bool onX = glm::abs(p.x - boundingBox.min.x) <= Config::physicsEpsilon || glm::abs(p.x - boundingBox.max.x) <= Config::physicsEpsilon;
+        const bool onY = glm::abs(p.y - boundingBox.min.y) <= Config::physicsEpsilon || glm::abs(p.y - boundingBox.max.y) <= Config::physicsEpsilon;
+        return onX && onY;
+    };
+
+    return std::ranges::all_of(borders, onCorner);
+}
+
+/// @brief Properties two entities must share to be merged, compared as a whole.
+auto mergeKey(const Entity::PhysicsSetup &setup, const Entity::PhysicsConstraints &constraints, const Entity::CollisionLayers &layers)
+{
+    return std::tuple{setup.canCollide, setup.elasticity, setup.mass, setup.baseFriction, constraints.friction, layers.category, layers.mask};
+}
+
+/// @brief Returns the source of the box entity @param i was merged in, following @param leaders.
+auto leaderOf(std::vector<int> &leaders, int i) -> int
+{
+    while (leaders[i] != i) {
+        leaders[i] = leaders[leaders[i]];
+        i = leaders[i];
+    }
+    return i;
+}
+
+/**
+ * @brief Merges the boxes touching along @param axis whose extent on the other axis is identical.
+ * @param keys Merge key of each box's source entity, boxes are only merged with boxes of the same key.
+ * @param leaders Entity each entity was merged with, the source of a merged box being its own leader.
+ */
+template<typename Key>
+auto mergeAlong(std::vector<Box> boxes, const int axis, const std::vector<Key> &keys, std::vector<int> &leaders) -> std::vector<Box>
+{
+    const int other = 1 - axis;
+
+    std::ranges::sort(boxes, [&keys, axis, other](const Box &a, const Box &b) -> bool {
+        return std::tuple{keys[a.source], a.bounds.min[other], a.bounds.max[other], a.bounds.min[axis]}
+               < std::tuple{keys[b.source], b.bounds.min[other], b.bounds.max[other], b.bounds.min[axis]};
+    });
+
+    std::vector<Box> merged{};
+    merged.reserve(boxes.size());
+
+    for (const auto &box : boxes) {
+        if (!merged.empty()) {
+            auto &last = merged.back();
+            const bool sameSpan = last.bounds.min[other] == box.bounds.min[other] && last.bounds.max[other] == box.bounds.max[other];
+
+            if (sameSpan && keys[last.source] == keys[box.source] && box.bounds.min[axis] <= last.bounds.max[axis] + Config::physicsEpsilon) {
+                last.bounds.max[axis] = std::max(last.bounds.max[axis], box.bounds.max[axis]);
+                last.count += box.count;
+                leaders[box.source] = last.source;
+                continue;
+            }
+        }
+
+        merged.push_back(box);
+    }
+
+    return merged;
+}
+
+} // namespace
+
+namespace Physics
+{
+
+auto mergeStaticBoxes(Entity::VectorTypes<Entity::PhysicsEntity> &entities, const size_t dynamicCount, ShapePool &shapes) -> TileMergeReport
+{
+    const auto size = entities.size();
+    TileMergeReport report{.before = size - dynamicCount};
+
+    std::vector<Box> boxes{};
+    std::vector<decltype(mergeKey({}, {}, {}))> keys(size);
+
+    /* Collect the fixed boxes */ {
+        const auto setups = entities.column<Entity::PhysicsSetup>();
+        const auto constraints = entities.column<Entity::PhysicsConstraints>();
+        const auto layers = entities.column<Entity::CollisionLayers>();
+        const auto bounds = entities.column<Entity::PhysicsBounds>();
+        const auto boxesBounds = entities.column<Entity::AABB>();
+        const auto cStates = entities.column<Entity::PhysicsCartesianState>();
+
+        for (size_t i = dynamicCount; i < size; ++i) {
+            // Rotated entities are not axis-aligned anymore.
+            if (setups[i].isNotFixed || setups[i].angle != 0.f || !isBox(shapes, bounds[i], boxesBounds[i])) {
+                continue;
+            }
+
+            keys[i] = mergeKey(setups[i], constraints[i], layers[i]);
+            boxes.push_back(Box{.bounds = worldBounds(cStates[i], boxesBounds[i]), .source = static_cast<int>(i)});
+        }
+    }
+
+    // Rows first, then rows of the same width stacked into rectangles.
+    const auto sources = boxes;
+    std::vector<int> leaders(size);
+    std::iota(leaders.begin(), leaders.end(), 0);
+    const auto merged = mergeAlong(mergeAlong(std::move(boxes), 0, keys, leaders), 1, keys, leaders);
+
+    /* Replace the merged entities */ {
+        std::vector<uint8_t> removed(size, 0);
+        // Entity created for the box whose source is the index, for the boxes made of several entities.
+        std::vector<size_t> created(size, 0);
+        for (const auto &box : sources) {
+            removed[box.source] = 1;
+        }
+
+        // Every merged box is the same unit square scaled to its extent.
+        // Same layout as the outlines of opaque images, see ImageVectorizer.
+        constexpr std::array<glm::vec2, 5> unitBorders{{{0.f, 0.f}, {0.f, 1.f}, {1.f, 1.f}, {1.f, 0.f}, {0.f, 0.f}}};
+        constexpr std::array<glm::vec2, 4> unitNormals{{{-1.f, 0.f}, {0.f, 1.f}, {1.f, 0.f}, {0.f, -1.f}}};
+        const auto unitBox = shapes.intern(unitBorders, unitNormals);
+
+        // Boxes made of a single entity keep it as it is.
+        for (const auto &box : merged) {
+            if (box.count == 1) {
+                removed[box.source] = 0;
+                continue;
+            }
+
+            const auto i = entities.size();
+            created[box.source] = i;
+            entities.resize(i + 1);
+            entities.at(i) = entities.at(box.source);
+
+            const auto extent = box.bounds.max - box.bounds.min;
+            entities.at<Entity::PhysicsBounds>(i) = Entity::PhysicsBounds{.shape = unitBox, .scale = extent};
+            entities.at<Entity::AABB>(i) = Entity::AABB{.min = {}, .max = extent};
+            entities.at<Entity::PhysicsCartesianState>(i).position = box.bounds.min;
+        }
+        removed.resize(entities.size(), 0);
+
+        // Compact the remaining entities, the moving ones are never removed so their indices do not change.
+        std::vector<uint32_t> compacted(entities.size(), 0);
+        std::iota(compacted.begin(), compacted.begin() + static_cast<ptrdiff_t>(dynamicCount), 0u);
+        size_t kept = dynamicCount;
+        for (size_t i = dynamicCount; i < entities.size(); ++i) {
+            if (removed[i]) {
+                continue;
+            }
+            if (kept != i) {
+                entities.at(kept) = entities.at(i);
+            }
+            compacted[i] = static_cast<uint32_t>(kept++);
+        }
+        // The merged boxes, appended last, are all kept.
+        report.firstMerged = kept - (entities.size() - size);
+        entities.resize(kept);
+
+        report.remap.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            report.remap[i] = removed[i] ? compacted[created[leaderOf(leaders, static_cast<int>(i))]] : compacted[i];
+        }
+    }
+
+    report.after = entities.size() - dynamicCount;
+
+    return report;
+}
+
+} // namespace Physics
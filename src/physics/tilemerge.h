@@ -0,0 +1,44 @@
+#ifndef JP_PHYSICS_TILEMERGE_H
+#define JP_PHYSICS_TILEMERGE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "src/entity/components.h"
+#include "src/entity/vector.h"
+#include "src/physics/shapepool.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Collider counts of the fixed entities before and after @fn mergeStaticBoxes.
+ */
+struct TileMergeReport
+{
+    /// @brief Fixed entities before the merge.
+    size_t before = 0;
+    /// @brief Fixed entities after the merge.
+    size_t after = 0;
+    /// @brief First entity created for a merged box, they are stored after every entity kept as it was.
+    size_t firstMerged = 0;
+    /// @brief Index after the merge of each entity before it, merged entities giving the index of their box.
+    std::vector<uint32_t> remap{};
+};
+
+/**
+ * @brief Merges touching fixed entities whose shape is their axis-aligned bounding box into larger boxes.
+ *
+ * Boxes sharing the same physical properties are first merged in rows of the same height, then rows of the same
+ * width are stacked. Merged entities are replaced by one entity per resulting box, so that a floor made of tiles
+ * becomes a single collider. Objects are left untouched, their entity indices must be updated from
+ * @var TileMergeReport::remap.
+ *
+ * @param dynamicCount Number of moving entities, stored first, they are left in place.
+ * @param shapes Pool of the entities' shapes, receives the unit box the merged entities are scaled from.
+ */
+auto mergeStaticBoxes(Entity::VectorTypes<Entity::PhysicsEntity> &entities, size_t dynamicCount, ShapePool &shapes) -> TileMergeReport;
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_TILEMERGE_H
@@ -0,0 +1,33 @@
+#include "src/physics/trace.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace Physics
+{
+
+auto CollisionTrace::save(const std::string &path) const -> bool
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+
+    const auto next = m_next.load(std::memory_order_acquire);
+    const auto count = std::min<uint64_t>(next, m_records.size());
+    const TraceHeader header{
+        .overwritten = static_cast<uint32_t>(std::min<uint64_t>(next - count, UINT32_MAX)),
+        .dropped = static_cast<uint32_t>(std::min<uint64_t>(m_dropped, UINT32_MAX)),
+        .count = count,
+    };
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    // The oldest record follows the newest one in the ring.
+    for (auto i = next - count; i != next; ++i) {
+        file.write(reinterpret_cast<const char *>(&m_records[i & (m_records.size() - 1)]), sizeof(TraceRecord));
+    }
+
+    return static_cast<bool>(file);
+}
+
+} // namespace Physics
@@ -0,0 +1,191 @@
+#ifndef JP_PHYSICS_TRACE_H
+#define JP_PHYSICS_TRACE_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "src/keywords.h"
+
+namespace Physics
+{
+
+/**
+ * @brief Axis tested by a narrow phase kernel, as stored by CollisionTrace.
+ * @note Only standard types, the file is read back by tools/tracedump.
+ */
+struct TraceRecord
+{
+    /// @brief Kernel of the axes tested from the axis cache, not tied to a pair of parts.
+    static constexpr uint8_t noKernel = UINT8_MAX;
+
+    /// @brief Step during which the axis was tested.
+    uint32_t tick = 0;
+    /// @brief First entity tested.
+    int32_t a = 0;
+    /// @brief Second entity tested.
+    int32_t b = 0;
+    /// @brief Index of the normal in its owner's part.
+    uint16_t axis = 0;
+    /// @brief 0 when the normal belongs to a, 1 for b.
+    uint8_t owner = 0;
+    /// @brief Kernel that tested the axis, Physics::pairKernelIndex of the kinds of the parts, @var noKernel for cached axes.
+    uint8_t kernel = 0;
+    /// @brief Set when the axis was the one cached from the previous step, tested before any kernel.
+    uint8_t cached = 0;
+    /// @brief Unused, keeps the record size explicit.
+    std::array<uint8_t, 3> reserved{};
+    /// @brief Axis, scaled like the entity it belongs to.
+    float normalX = 0.f;
+    float normalY = 0.f;
+    /// @brief Projection of a on the axis.
+    float aMin = 0.f;
+    float aMax = 0.f;
+    /// @brief Projection of b on the axis.
+    float bMin = 0.f;
+    float bMax = 0.f;
+
+    /// @brief Overlap of the projections, negative when the axis separates the pair.
+    _nodiscard constexpr auto overlap() const noexcept -> float
+    {
+        const float ab = aMax - bMin;
+        const float ba = bMax - aMin;
+        return ab < ba ? ab : ba;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<TraceRecord> && sizeof(TraceRecord) == 44, "Trace records are written as is.");
+
+/**
+ * @brief Beginning of a trace file, followed by @var count records, oldest first.
+ */
+struct TraceHeader
+{
+    /// @brief Identifies trace files, "JPCT".
+    std::array<char, 4> magic{'J', 'P', 'C', 'T'};
+    /// @brief Format version, bumped when TraceRecord changes.
+    uint32_t version = 2;
+    /// @brief Size of a record, checked when reading.
+    uint32_t recordSize = sizeof(TraceRecord);
+    /// @brief Records lost because the ring wrapped around.
+    uint32_t overwritten = 0;
+    /// @brief Records dropped because a single step tested more axes than the ring holds.
+    uint32_t dropped = 0;
+    /// @brief Unused, keeps @var count aligned.
+    uint32_t reserved = 0;
+    /// @brief Number of records following the header.
+    uint64_t count = 0;
+};
+
+/**
+ * @brief Ring of the axes tested by the narrow phase, saved as a binary file for tools/tracedump.
+ *
+ * Each axis test is written as a fixed-size record at a slot reserved with an atomic increment, so the narrow phase
+ * workers record concurrently without locking or formatting anything. Once full, the oldest records are overwritten.
+ *
+ * Records are not atomic, two workers must never write the same slot: the slots reserved during one step are unique as
+ * long as they do not wrap around the ring. Records beyond the capacity within a step are dropped instead, the ring
+ * only wrapping between steps, see @fn beginStep and @fn endStep.
+ *
+ * @note @fn save, @fn beginStep and @fn endStep must not run while the narrow phase does.
+ */
+class CollisionTrace
+{
+public:
+    /// @brief Allocates room for @param capacity records, rounded up to a power of two, 0 disables the trace.
+    void reserve(const size_t capacity)
+    {
+        m_records.assign(capacity == 0 ? 0 : std::bit_ceil(capacity), TraceRecord{});
+        m_next.store(0, std::memory_order_relaxed);
+        m_stepBegin = 0;
+        m_dropped = 0;
+    }
+
+    /// @brief Tells if records are kept.
+    _nodiscard auto enabled() const noexcept -> bool { return !m_records.empty(); }
+
+    /// @brief Starts the records of a step, before the narrow phase.
+    void beginStep() noexcept { m_stepBegin = m_next.load(std::memory_order_relaxed); }
+
+    /// @brief Ends the records of a step, forgetting the slots reserved past the capacity.
+    void endStep() noexcept
+    {
+        const auto last = m_stepBegin + m_records.size();
+        if (const auto next = m_next.load(std::memory_order_relaxed); next > last) {
+            m_dropped += next - last;
+            m_next.store(last, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief Stores @param record, overwriting the oldest one of the previous steps when full.
+    void record(const TraceRecord &record) noexcept
+    {
+        const auto slot = m_next.fetch_add(1, std::memory_order_relaxed);
+        // Another worker may be writing the slot this one would wrap to.
+        if (slot - m_stepBegin >= m_records.size()) {
+            return;
+        }
+        m_records[slot & (m_records.size() - 1)] = record;
+    }
+
+    /// @brief Writes the records to @param path, oldest first. Returns false if the file could not be written.
+    auto save(const std::string &path) const -> bool;
+
+private:
+    /// @brief Records, indexed by their sequence number masked by the capacity.
+    std::vector<TraceRecord> m_records{};
+    /// @brief Sequence number of the next record.
+    std::atomic<uint64_t> m_next = 0;
+    /// @brief Sequence number of the first record of the current step.
+    uint64_t m_stepBegin = 0;
+    /// @brief Records dropped by the steps that tested more axes than the ring holds.
+    uint64_t m_dropped = 0;
+};
+
+/**
+ * @brief Pair tested by a narrow phase kernel, fills the records of its axes.
+ */
+struct TraceScope
+{
+    /// @brief Trace receiving the records.
+    CollisionTrace *trace = nullptr;
+    /// @brief Current step.
+    uint32_t tick = 0;
+    /// @brief First entity tested.
+    int32_t a = 0;
+    /// @brief Second entity tested.
+    int32_t b = 0;
+    /// @brief Kernel testing the pair.
+    uint8_t kernel = 0;
+    /// @brief Set when the axes are the ones cached from the previous step.
+    uint8_t cached = 0;
+
+    /// @brief Records the projections of both parts on axis @param index of @param owner, of direction (@param x, @param y).
+    void axis(const uint32_t index, const uint8_t owner, const float x, const float y, const float aMin, const float aMax, const float bMin, const float bMax) const noexcept
+    {
+        trace->record(TraceRecord{
+            .tick = tick,
+            .a = a,
+            .b = b,
+            .axis = static_cast<uint16_t>(index),
+            .owner = owner,
+            .kernel = kernel,
+            .cached = cached,
+            .normalX = x,
+            .normalY = y,
+            .aMin = aMin,
+            .aMax = aMax,
+            .bMin = bMin,
+            .bMax = bMax,
+        });
+    }
+};
+
+} // namespace Physics
+
+#endif // JP_PHYSICS_TRACE_H
@@ -3,12 +3,18 @@
 
 #include <gsl/gsl-lite.hpp>
 
-#include <set>
+#include <span>
+#include <vector>
 
 #include "src/entity/vector.h"
 #include "src/graphics/chunk.h"
 #include "src/graphics/resources.h"
 #include "src/graphics/types.h"
+#include "src/keywords.h"
+#include "src/physics/pairset.h"
+#include "src/physics/shapepool.h"
+#include "src/physics/statictree.h"
+#include "src/world/snapshot.h"
 
 namespace World {
 
@@ -36,11 +42,45 @@ public:
     std::vector<std::span<Graphics::ObjectData>> references{};
     /// @brief Owned object data entries.
     std::vector<Graphics::ObjectData> objects{};
-    /// @brief Physics entities associated with objects.
+    /**
+     * @brief Physics entities associated with objects.
+     * The first @var dynamicCount entities are the moving ones (dynamic store), the remaining ones are fixed (static store).
+     * The static store is not modified after load, and its world bounds are computed once by the loader.
+     */
     Entity::VectorTypes<Entity::PhysicsEntity> entities{};
+    /// @brief Number of moving entities, stored at the beginning of @var entities.
+    size_t dynamicCount = 0;
+    /// @brief Index in @var objects of the object of each moving entity.
+    std::vector<uint32_t> dynamicObjects{};
+    /// @brief First entity created by Physics::mergeStaticBoxes, the merged boxes have no object of their own.
+    size_t firstMergedEntity = 0;
+
+    /// @brief Positions of the moving entities handed from the physics thread to the renderer.
+    SnapshotBuffer snapshots{};
+
+    /// @brief Column @param T of the moving entities.
+    template<typename T>
+    _nodiscard auto dynamicColumn() -> std::span<T>
+    {
+        return entities.column<T>().first(dynamicCount);
+    }
+    /// @brief Column @param T of the fixed entities, entity indices are offset by @var dynamicCount.
+    template<typename T>
+    _nodiscard auto staticColumn() const -> std::span<const T>
+    {
+        return entities.column<T>().subspan(dynamicCount);
+    }
+
+    /// @brief Collision shapes of the entities, interned at load, see Entity::PhysicsBounds.
+    Physics::ShapePool shapes{};
+
+    /// @brief Hierarchy over the fixed entities, built once the map is loaded.
+    Physics::StaticTree staticTree{};
 
-    /// @brief Set of currently colliding entity pairs.
-    std::set<std::pair<int, int>> collisions;
+    /// @brief Set of currently colliding entity pairs, keys built by Physics::pairKey.
+    Physics::PairSet collisions{};
+    /// @brief Colliding entity pairs of the previous step, used to tell contacts beginning and ending.
+    Physics::PairSet previousCollisions{};
 };
 
 } // namespace World
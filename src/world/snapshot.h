@@ -0,0 +1,125 @@
+#ifndef JP_WORLD_SNAPSHOT_H
+#define JP_WORLD_SNAPSHOT_H
+
+#include <glm/vec2.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "src/keywords.h"
+
+namespace World {
+
+/**
+ * @brief State of the moving entities published by the physics thread for the renderer.
+ */
+struct Snapshot
+{
+    /// @brief Position of each moving entity at the end of the last tick, indexed like Scene::dynamicObjects.
+    std::vector<glm::vec2> positions{};
+    /// @brief Position of each moving entity at the beginning of the last tick, indexed like @var positions.
+    std::vector<glm::vec2> previous{};
+    /// @brief Blending factor from @var previous to @var positions when published, see Physics::Engine::interpolationAlpha.
+    float alpha = 1.f;
+    /// @brief Number of snapshots published before this one.
+    uint64_t sequence = 0;
+    /// @brief Time at which the snapshot was published.
+    std::chrono::steady_clock::time_point published{};
+};
+
+/**
+ * @brief Lock-free triple buffer of snapshots, one producer (physics) and one consumer (renderer).
+ *
+ * The producer fills the back buffer and swaps it with the middle one, the consumer swaps the middle one with its
+ * front buffer when it holds a newer snapshot. The swaps are single atomic exchanges of the middle index, so neither
+ * thread ever waits for the other: physics and render rates are independent, the renderer always drawing the newest
+ * snapshot published.
+ *
+ * @note Buffers are sized by @fn resize before the threads start, publishing then never allocates.
+ */
+class SnapshotBuffer
+{
+public:
+    /// @brief Sizes every buffer for @param count moving entities.
+    void resize(const size_t count)
+    {
+        for (auto &snapshot : m_buffers) {
+            snapshot.positions.assign(count, glm::vec2{});
+            snapshot.previous.assign(count, glm::vec2{});
+        }
+    }
+
+    /// @brief Returns the buffer the producer fills, published by @fn publish.
+    _nodiscard auto back() noexcept -> Snapshot & { return m_buffers[m_back]; }
+
+    /// @brief Publishes the back buffer, the producer then fills the previous middle one.
+    void publish() noexcept
+    {
+        auto &snapshot = m_buffers[m_back];
+        snapshot.sequence = m_published++;
+        snapshot.published = std::chrono::steady_clock::now();
+        m_back = m_middle.exchange(static_cast<uint8_t>(m_back | fresh), std::memory_order_acq_rel) & indexMask;
+    }
+
+    /**
+     * @brief Picks the newest snapshot up, if one was published since the last call.
+     * @return True when @fn front changed.
+     */
+    auto consume() noexcept -> bool
+    {
+        if ((m_middle.load(std::memory_order_relaxed) & fresh) == 0) {
+            return false;
+        }
+
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & indexMask;
+
+        const auto &snapshot = m_buffers[m_front];
+        m_latency = std::chrono::steady_clock::now() - snapshot.published;
+        m_skipped += snapshot.sequence - m_lastSequence - 1;
+        m_lastSequence = snapshot.sequence;
+        return true;
+    }
+
+    /// @brief Returns the last snapshot picked up by @fn consume.
+    _nodiscard auto front() const noexcept -> const Snapshot & { return m_buffers[m_front]; }
+    /// @brief Returns the time between the publication and the consumption of @fn front.
+    _nodiscard auto latency() const noexcept -> std::chrono::duration<double, std::milli> { return m_latency; }
+    /// @brief Returns the number of snapshots replaced by a newer one before being consumed.
+    _nodiscard auto skipped() const noexcept -> uint64_t { return m_skipped; }
+
+private:
+    /// @brief Bit set in @var m_middle when it holds a snapshot not consumed yet.
+    static constexpr uint8_t fresh = 0b100;
+    /// @brief Bits of @var m_middle holding the buffer index.
+    static constexpr uint8_t indexMask = 0b11;
+
+    /// @brief The three buffers, each one owned by the producer, the consumer, or in between.
+    std::array<Snapshot, 3> m_buffers{};
+    /// @brief Buffer between the threads, with the @var fresh bit.
+    std::atomic<uint8_t> m_middle = 1;
+
+    /* Producer side */
+
+    /// @brief Buffer filled by the producer.
+    uint8_t m_back = 0;
+    /// @brief Number of snapshots published.
+    uint64_t m_published = 0;
+
+    /* Consumer side */
+
+    /// @brief Buffer read by the consumer.
+    uint8_t m_front = 2;
+    /// @brief Sequence of the last snapshot consumed.
+    uint64_t m_lastSequence = -1;
+    /// @brief Latency of the last snapshot consumed.
+    std::chrono::duration<double, std::milli> m_latency{};
+    /// @brief Snapshots never consumed.
+    uint64_t m_skipped = 0;
+};
+
+} // namespace World
+
+#endif // JP_WORLD_SNAPSHOT_H
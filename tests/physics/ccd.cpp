@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include "src/physics/ccd.h"
+
+namespace
+{
+
+/// @brief Unit box whose min corner is at @param min.
+auto unitBox(const glm::vec2 min) -> Entity::AABB
+{
+    return Entity::AABB{.min = min, .max = min + glm::vec2{1.f, 1.f}};
+}
+
+} // namespace
+
+TEST(TimeOfImpact, OverlapAtStartReturnsOne)
+{
+    glm::vec2 normal{};
+    EXPECT_EQ(Physics::timeOfImpact(unitBox({0.f, 0.f}), {10.f, 0.f}, unitBox({0.5f, 0.5f}), normal), 1.f);
+    EXPECT_EQ(normal, glm::vec2{});
+
+    // Touching faces count as an overlap too.
+    EXPECT_EQ(Physics::timeOfImpact(unitBox({0.f, 0.f}), {10.f, 0.f}, unitBox({1.f, 0.f}), normal), 1.f);
+    EXPECT_EQ(Physics::timeOfImpact(unitBox({0.f, 0.f}), {0.f, 0.f}, unitBox({0.f, 0.f}), normal), 1.f);
+}
+
+TEST(TimeOfImpact, MissReturnsOne)
+{
+    glm::vec2 normal{};
+    // Too short.
+    EXPECT_EQ(Physics::timeOfImpact(unitBox({0.f, 0.f}), {2.f, 0.f}, unitBox({5.f, 0.f}), normal), 1.f);
+    // Moving away.
+    EXPECT_EQ(Physics::timeOfImpact(unitBox({0.f, 0.f}), {-10.f, 0.f}, unitBox({5.f, 0.f}), normal), 1.f);
+    // Passing just above.
+    EXPECT_EQ(Physics::timeOfImpact(unitBox({0.f, 0.f}), {10.f, 0.f}, unitBox({5.f, 1.01f}), normal), 1.f);
+    // Diagonal passing beside the corner.
+    EXPECT_EQ(Physics::timeOfImpact(unitBox({0.f, 0.f}), {10.f, 10.f}, unitBox({5.f, 0.f}), normal), 1.f);
+}
+
+TEST(TimeOfImpact, GrazingHit)
+{
+    glm::vec2 normal{};
+
+    // Sliding along the bottom face of the target, the edges only touch.
+    EXPECT_FLOAT_EQ(Physics::timeOfImpact(unitBox({0.f, 0.f}), {10.f, 0.f}, unitBox({5.f, 1.f}), normal), 0.4f);
+    EXPECT_EQ(normal, (glm::vec2{-1.f, 0.f}));
+
+    // Corner against corner, entering both slabs at once: the first axis keeps the normal.
+    EXPECT_FLOAT_EQ(Physics::timeOfImpact(unitBox({0.f, 0.f}), {4.f, 4.f}, unitBox({2.f, 2.f}), normal), 0.25f);
+    EXPECT_EQ(normal, (glm::vec2{-1.f, 0.f}));
+}
+
+TEST(TimeOfImpact, NormalFacesTheMovingBox)
+{
+    struct Case
+    {
+        glm::vec2 displacement;
+        glm::vec2 target;
+        glm::vec2 normal;
+    };
+    // From the unit box at the origin towards a unit box 4 units away on each side, entering after 3 units.
+    const Case cases[] = {
+        {{8.f, 0.f}, {4.f, 0.f}, {-1.f, 0.f}},
+        {{-8.f, 0.f}, {-4.f, 0.f}, {1.f, 0.f}},
+        {{0.f, 8.f}, {0.f, 4.f}, {0.f, -1.f}},
+        {{0.f, -8.f}, {0.f, -4.f}, {0.f, 1.f}},
+    };
+
+    for (const auto &[displacement, target, expected] : cases) {
+        glm::vec2 normal{};
+        EXPECT_FLOAT_EQ(Physics::timeOfImpact(unitBox({0.f, 0.f}), displacement, unitBox(target), normal), 3.f / 8.f);
+        EXPECT_EQ(normal, expected);
+    }
+
+    // Already within the slab of y, the normal is along x even with a larger y displacement.
+    glm::vec2 normal{};
+    EXPECT_FLOAT_EQ(Physics::timeOfImpact(unitBox({0.f, 0.f}), {4.f, 8.f}, Entity::AABB{.min = {2.f, -10.f}, .max = {3.f, 10.f}}, normal),
+                    0.25f);
+    EXPECT_EQ(normal, (glm::vec2{-1.f, 0.f}));
+}
+
+TEST(NeedsSweep, ComparesWithExtent)
+{
+    const auto box = Entity::AABB{.min = {0.f, 0.f}, .max = {2.f, 1.f}};
+    EXPECT_FALSE(Physics::needsSweep(box, {2.f, 1.f}));
+    EXPECT_FALSE(Physics::needsSweep(box, {-2.f, -1.f}));
+    EXPECT_TRUE(Physics::needsSweep(box, {-2.5f, 0.f}));
+    EXPECT_TRUE(Physics::needsSweep(box, {0.f, 1.5f}));
+}
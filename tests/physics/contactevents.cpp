@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "src/physics/contactevents.h"
+
+namespace
+{
+
+constexpr int events = 200000;
+
+/// @brief Event numbered @param sequence, the consumer checking the order on it.
+auto numbered(const int sequence) -> Physics::ContactEvent
+{
+    return Physics::ContactEvent{.a = sequence, .b = sequence + 1, .depth = static_cast<float>(sequence)};
+}
+
+/**
+ * @brief Pushes @var events numbered events from another thread while draining @param queue.
+ * @return The sequences received, in order, and writes to @param pushed the number of pushes that succeeded.
+ */
+auto pushAndDrain(Physics::ContactEventQueue &queue, int &pushed) -> std::vector<int>
+{
+    std::atomic<bool> done = false;
+    std::thread producer([&queue, &pushed, &done]() -> void {
+        for (int sequence = 0; sequence < events; ++sequence) {
+            pushed += queue.push(numbered(sequence)) ? 1 : 0;
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    std::vector<int> received{};
+    received.reserve(events);
+    const auto receive = [&received](const Physics::ContactEvent &event) -> void {
+        // Only whole events come out, every field derived from the sequence.
+        EXPECT_EQ(event.b, event.a + 1);
+        EXPECT_EQ(event.depth, static_cast<float>(event.a));
+        received.push_back(event.a);
+    };
+    while (!done.load(std::memory_order_acquire)) {
+        queue.drain(receive);
+    }
+    producer.join();
+    queue.drain(receive);
+
+    return received;
+}
+
+} // namespace
+
+TEST(ContactEventQueue, CapacityIsAPowerOfTwo)
+{
+    EXPECT_EQ(Physics::ContactEventQueue(5).capacity(), 8u);
+    EXPECT_EQ(Physics::ContactEventQueue(64).capacity(), 64u);
+    EXPECT_EQ(Physics::ContactEventQueue(0).capacity(), 2u);
+}
+
+TEST(ContactEventQueue, DrainingSubscribes)
+{
+    Physics::ContactEventQueue queue(8);
+    EXPECT_FALSE(queue.subscribed());
+
+    EXPECT_EQ(queue.drain([](const Physics::ContactEvent &) -> void { FAIL(); }), 0u);
+    EXPECT_TRUE(queue.subscribed());
+}
+
+TEST(ContactEventQueue, DropWhenFull)
+{
+    Physics::ContactEventQueue queue(8);
+    queue.setOverflow(Physics::ContactOverflow::Drop);
+
+    for (int sequence = 0; sequence < 10; ++sequence) {
+        EXPECT_EQ(queue.push(numbered(sequence)), sequence < 8);
+    }
+    EXPECT_EQ(queue.dropped(), 2u);
+
+    // The first events are kept, in order, and draining makes room again.
+    std::vector<int> received{};
+    EXPECT_EQ(queue.drain([&received](const Physics::ContactEvent &event) -> void { received.push_back(event.a); }), 8u);
+    EXPECT_EQ(received, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+    EXPECT_TRUE(queue.push(numbered(10)));
+    EXPECT_EQ(queue.dropped(), 2u);
+}
+
+TEST(ContactEventQueue, ConcurrentDrop)
+{
+    Physics::ContactEventQueue queue(64);
+    queue.setOverflow(Physics::ContactOverflow::Drop);
+
+    int pushed = 0;
+    const auto received = pushAndDrain(queue, pushed);
+
+    // Every event is either received or counted as dropped, the received ones keep their order.
+    EXPECT_EQ(received.size(), static_cast<size_t>(pushed));
+    EXPECT_EQ(received.size() + queue.dropped(), static_cast<size_t>(events));
+    EXPECT_EQ(std::ranges::adjacent_find(received, std::ranges::greater_equal{}), received.end());
+}
+
+TEST(ContactEventQueue, ConcurrentWait)
+{
+    Physics::ContactEventQueue queue(64);
+    queue.setOverflow(Physics::ContactOverflow::Wait);
+
+    int pushed = 0;
+    const auto received = pushAndDrain(queue, pushed);
+
+    // The producer waits for room, nothing is lost.
+    EXPECT_EQ(pushed, events);
+    EXPECT_EQ(queue.dropped(), 0u);
+    ASSERT_EQ(received.size(), static_cast<size_t>(events));
+    for (int sequence = 0; sequence < events; ++sequence) {
+        ASSERT_EQ(received[sequence], sequence);
+    }
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "src/physics/outline.h"
+
+namespace
+{
+
+using Path = std::vector<glm::vec2>;
+
+/// @brief Concave L, 3 units large, counter-clockwise.
+const Path lShape{{0.f, 0.f}, {2.f, 0.f}, {2.f, 1.f}, {1.f, 1.f}, {1.f, 2.f}, {0.f, 2.f}};
+
+/// @brief Comb of 3 teeth on a 5x1 base, 8 units large, needing at least 4 convex parts.
+const Path comb{{0.f, 0.f}, {5.f, 0.f}, {5.f, 2.f}, {4.f, 2.f}, {4.f, 1.f}, {3.f, 1.f}, {3.f, 2.f}, {2.f, 2.f}, {2.f, 1.f}, {1.f, 1.f}, {1.f, 2.f}, {0.f, 2.f}};
+
+/// @brief Signed area of @param polygon, positive when counter-clockwise.
+auto signedArea(const Path &polygon) -> float
+{
+    float area = 0.f;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        area += polygon[j].x * polygon[i].y - polygon[j].y * polygon[i].x;
+    }
+    return area / 2.f;
+}
+
+/// @brief Returns true if @param polygon is counter-clockwise and has no reflex vertex.
+auto isConvex(const Path &polygon) -> bool
+{
+    const auto count = polygon.size();
+    for (size_t i = 0; i < count; ++i) {
+        const auto in = polygon[(i + 1) % count] - polygon[i];
+        const auto out = polygon[(i + 2) % count] - polygon[(i + 1) % count];
+        if (in.x * out.y - in.y * out.x < -Config::physicsEpsilon) {
+            return false;
+        }
+    }
+    return count >= 3 && signedArea(polygon) > 0.f;
+}
+
+/// @brief Checks every part of @param parts is convex, and that they cover @param area together.
+void expectConvexCover(const std::vector<Path> &parts, const float area)
+{
+    float sum = 0.f;
+    for (const auto &part : parts) {
+        EXPECT_TRUE(isConvex(part));
+        sum += signedArea(part);
+    }
+    EXPECT_NEAR(sum, area, 1e-4f);
+}
+
+/// @brief Outline as ImageVectorizer makes it, each path closed by a copy of its first point.
+auto traced(const std::vector<Path> &paths) -> Path
+{
+    Path points{};
+    for (const auto &path : paths) {
+        points.insert(points.end(), path.begin(), path.end());
+        points.push_back(path.front());
+    }
+    return points;
+}
+
+/// @brief Borders of @param parts.
+auto bordersOf(const std::vector<Physics::ConvexPart> &parts) -> std::vector<Path>
+{
+    std::vector<Path> borders{};
+    for (const auto &part : parts) {
+        borders.push_back(part.borders);
+    }
+    return borders;
+}
+
+} // namespace
+
+TEST(DecomposeConvex, ConvexPolygonStaysWhole)
+{
+    const Path square{{0.f, 0.f}, {1.f, 0.f}, {1.f, 1.f}, {0.f, 1.f}};
+    const auto parts = Physics::decomposeConvex(square);
+    ASSERT_EQ(parts.size(), 1u);
+    expectConvexCover(parts, 1.f);
+}
+
+TEST(DecomposeConvex, ConcaveL)
+{
+    const auto parts = Physics::decomposeConvex(lShape);
+    EXPECT_EQ(parts.size(), 2u);
+    expectConvexCover(parts, 3.f);
+
+    // Clockwise paths give counter-clockwise parts as well.
+    const Path clockwise(lShape.rbegin(), lShape.rend());
+    expectConvexCover(Physics::decomposeConvex(clockwise), 3.f);
+}
+
+TEST(DecomposeConvex, Comb)
+{
+    const auto parts = Physics::decomposeConvex(comb);
+    EXPECT_GE(parts.size(), 4u);
+    expectConvexCover(parts, 8.f);
+}
+
+TEST(SimplifyPath, KeepsCornersWithinTolerance)
+{
+    // Square whose bottom border wobbles by less than the tolerance.
+    const Path wobbly{{0.f, 0.f}, {1.f, 0.01f}, {2.f, -0.01f}, {3.f, 0.f}, {3.f, 3.f}, {0.f, 3.f}};
+
+    EXPECT_EQ(Physics::simplifyPath(wobbly, 0.f), wobbly);
+    EXPECT_EQ(Physics::simplifyPath(wobbly, 0.02f), (Path{{0.f, 0.f}, {3.f, 0.f}, {3.f, 3.f}, {0.f, 3.f}}));
+    EXPECT_EQ(Physics::simplifyPath(wobbly, 0.005f), wobbly);
+}
+
+TEST(RemoveCollinear, CollinearRun)
+{
+    // Run of points along the bottom border, a duplicate, and a point in the middle of the left border.
+    const Path run{{0.f, 0.f}, {1.f, 0.f}, {2.f, 0.f}, {2.f, 0.f}, {3.f, 0.f}, {3.f, 3.f}, {0.f, 3.f}, {0.f, 1.5f}};
+
+    const auto path = Physics::removeCollinear(run, Config::outlineAngleTolerance);
+    EXPECT_EQ(path, (Path{{0.f, 0.f}, {3.f, 0.f}, {3.f, 3.f}, {0.f, 3.f}}));
+
+    // A turn larger than the tolerance is kept.
+    const Path bent{{0.f, 0.f}, {1.f, 0.1f}, {2.f, 0.f}, {2.f, 2.f}, {0.f, 2.f}};
+    EXPECT_EQ(Physics::removeCollinear(bent, Config::outlineAngleTolerance).size(), 5u);
+}
+
+TEST(BuildConvexParts, CollinearRunGivesOneBox)
+{
+    const Path run{{0.f, 0.f}, {1.f, 0.f}, {2.f, 0.f}, {3.f, 0.f}, {3.f, 1.f}, {3.f, 2.f}, {0.f, 2.f}};
+
+    const auto parts = Physics::buildConvexParts(traced({run}), Physics::OutlineTolerances{});
+    ASSERT_EQ(parts.size(), 1u);
+    EXPECT_EQ(parts[0].borders.size(), 4u);
+    // Opposite borders share their SAT axis.
+    EXPECT_EQ(parts[0].normals.size(), 2u);
+    expectConvexCover(bordersOf(parts), 6.f);
+}
+
+TEST(BuildConvexParts, ConcaveL)
+{
+    const auto parts = Physics::buildConvexParts(traced({lShape}), Physics::OutlineTolerances{});
+    EXPECT_EQ(parts.size(), 2u);
+    expectConvexCover(bordersOf(parts), 3.f);
+}
+
+TEST(BuildConvexParts, HoleIsFilled)
+{
+    const Path outer{{0.f, 0.f}, {4.f, 0.f}, {4.f, 4.f}, {0.f, 4.f}};
+    const Path hole{{1.f, 1.f}, {1.f, 3.f}, {3.f, 3.f}, {3.f, 1.f}};
+
+    const auto parts = Physics::buildConvexParts(traced({outer, hole}), Physics::OutlineTolerances{});
+    ASSERT_EQ(parts.size(), 1u);
+    expectConvexCover(bordersOf(parts), 16.f);
+}
+
+TEST(BuildConvexParts, MaxPartsFallsBackToHull)
+{
+    const auto points = traced({comb});
+
+    // Within the limit, the parts cover the comb exactly.
+    const auto parts = Physics::buildConvexParts(points, Physics::OutlineTolerances{.maxParts = 8});
+    EXPECT_GE(parts.size(), 4u);
+    EXPECT_LE(parts.size(), 8u);
+    expectConvexCover(bordersOf(parts), 8.f);
+
+    // Beyond it, the convex hull of the comb, its 5x2 bounds, is used.
+    const auto hull = Physics::buildConvexParts(points, Physics::OutlineTolerances{.maxParts = 3});
+    ASSERT_EQ(hull.size(), 1u);
+    expectConvexCover(bordersOf(hull), 10.f);
+
+    // The L needs 2 parts, its hull cuts the inner corner.
+    const auto lHull = Physics::buildConvexParts(traced({lShape}), Physics::OutlineTolerances{.maxParts = 1});
+    ASSERT_EQ(lHull.size(), 1u);
+    expectConvexCover(bordersOf(lHull), 3.5f);
+}
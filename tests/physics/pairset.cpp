@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "src/physics/pairmap.h"
+#include "src/physics/pairset.h"
+
+namespace
+{
+
+/// @brief Keys of distinct pairs sharing the home slot of pairKey(0, 1) in a table of @param slotCount slots.
+auto collidingKeys(const size_t slotCount, const size_t count) -> std::vector<uint64_t>
+{
+    const auto mask = slotCount - 1;
+    const auto home = Physics::pairHash(Physics::pairKey(0, 1)) & mask;
+
+    std::vector<uint64_t> keys{};
+    for (int b = 1; keys.size() < count; ++b) {
+        const auto key = Physics::pairKey(0, b);
+        if ((Physics::pairHash(key) & mask) == home) {
+            keys.push_back(key);
+        }
+    }
+    return keys;
+}
+
+} // namespace
+
+TEST(PairKey, IsSymmetricAndRoundTrips)
+{
+    EXPECT_EQ(Physics::pairKey(3, 7), Physics::pairKey(7, 3));
+    EXPECT_NE(Physics::pairKey(3, 7), Physics::pairKey(3, 8));
+
+    const auto key = Physics::pairKey(42, 5);
+    EXPECT_EQ(Physics::pairFirst(key), 5);
+    EXPECT_EQ(Physics::pairSecond(key), 42);
+}
+
+TEST(PairSet, InsertContainsAcrossGrowth)
+{
+    Physics::PairSet set(4);
+
+    for (int a = 0; a < 100; ++a) {
+        for (int b = a + 1; b < a + 10; ++b) {
+            EXPECT_TRUE(set.insert(Physics::pairKey(a, b)));
+        }
+    }
+    EXPECT_EQ(set.size(), 900u);
+    EXPECT_GT(set.allocations(), 1u);
+
+    for (int a = 0; a < 100; ++a) {
+        for (int b = a + 1; b < a + 10; ++b) {
+            EXPECT_TRUE(set.contains(Physics::pairKey(b, a)));
+            EXPECT_FALSE(set.insert(Physics::pairKey(a, b)));
+        }
+        EXPECT_FALSE(set.contains(Physics::pairKey(a, a + 10)));
+    }
+    EXPECT_EQ(set.size(), 900u);
+
+    // Keys are listed in insertion order.
+    EXPECT_EQ(set.keys().front(), Physics::pairKey(0, 1));
+    EXPECT_EQ(set.keys().back(), Physics::pairKey(99, 108));
+}
+
+TEST(PairSet, CollidingKeysProbe)
+{
+    // Default capacity of 64 pairs, 128 slots.
+    Physics::PairSet set{};
+    const auto keys = collidingKeys(128, 16);
+
+    // Every second key is inserted, the others probe the same run without being found.
+    for (size_t i = 0; i < keys.size(); i += 2) {
+        EXPECT_TRUE(set.insert(keys[i]));
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(set.contains(keys[i]), i % 2 == 0);
+    }
+    EXPECT_EQ(set.allocations(), 1u);
+}
+
+TEST(PairSet, ClearKeepsCapacity)
+{
+    Physics::PairSet set(4);
+    for (int b = 1; b <= 500; ++b) {
+        set.insert(Physics::pairKey(0, b));
+    }
+    const auto allocations = set.allocations();
+
+    for (int step = 0; step < 10; ++step) {
+        set.clear();
+        EXPECT_TRUE(set.empty());
+        EXPECT_FALSE(set.contains(Physics::pairKey(0, 1)));
+
+        for (int b = 1; b <= 500; ++b) {
+            EXPECT_TRUE(set.insert(Physics::pairKey(step, b + step + 1)));
+        }
+        EXPECT_EQ(set.size(), 500u);
+    }
+    EXPECT_EQ(set.allocations(), allocations);
+}
+
+TEST(PairSet, SwapExchangesContent)
+{
+    Physics::PairSet a{};
+    Physics::PairSet b{};
+    a.insert(Physics::pairKey(1, 2));
+
+    a.swap(b);
+    EXPECT_TRUE(a.empty());
+    EXPECT_TRUE(b.contains(Physics::pairKey(1, 2)));
+}
+
+TEST(PairMap, InsertOrAssignAcrossGrowth)
+{
+    Physics::PairMap<int> map(4);
+
+    for (int b = 1; b <= 1000; ++b) {
+        map.insertOrAssign(Physics::pairKey(0, b), b);
+    }
+    EXPECT_EQ(map.size(), 1000u);
+    EXPECT_GT(map.allocations(), 1u);
+
+    // Assigning an existing key replaces the value without adding an entry.
+    for (int b = 1; b <= 1000; b += 2) {
+        map.insertOrAssign(Physics::pairKey(b, 0), -b);
+    }
+    EXPECT_EQ(map.size(), 1000u);
+
+    for (int b = 1; b <= 1000; ++b) {
+        const auto *value = map.find(Physics::pairKey(0, b));
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, b % 2 == 1 ? -b : b);
+    }
+    EXPECT_EQ(map.find(Physics::pairKey(0, 1001)), nullptr);
+}
+
+TEST(PairMap, CollidingKeysProbe)
+{
+    Physics::PairMap<size_t> map{};
+    const auto keys = collidingKeys(128, 16);
+
+    for (size_t i = 0; i < keys.size(); i += 2) {
+        map.insertOrAssign(keys[i], i);
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+        const auto *value = map.find(keys[i]);
+        if (i % 2 == 0) {
+            ASSERT_NE(value, nullptr);
+            EXPECT_EQ(*value, i);
+        } else {
+            EXPECT_EQ(value, nullptr);
+        }
+    }
+    EXPECT_EQ(map.allocations(), 1u);
+}
+
+TEST(PairMap, ClearKeepsCapacity)
+{
+    Physics::PairMap<float> map(4);
+    for (int b = 1; b <= 500; ++b) {
+        map.insertOrAssign(Physics::pairKey(0, b), 1.f);
+    }
+    const auto allocations = map.allocations();
+
+    for (int step = 0; step < 10; ++step) {
+        map.clear();
+        EXPECT_EQ(map.size(), 0u);
+        EXPECT_EQ(map.find(Physics::pairKey(0, 1)), nullptr);
+
+        for (int b = 1; b <= 500; ++b) {
+            map.insertOrAssign(Physics::pairKey(step, b + step + 1), static_cast<float>(step));
+        }
+        EXPECT_EQ(map.size(), 500u);
+    }
+    EXPECT_EQ(map.allocations(), allocations);
+}
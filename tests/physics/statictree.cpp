@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "src/physics/entity.h"
+#include "src/physics/query.h"
+#include "src/physics/statictree.h"
+
+namespace
+{
+
+using Entities = Physics::StaticTree::Entities;
+
+/// @brief Fills @param entities with boxes of random sizes scattered over a 200x200 area, one in four moving.
+void fillEntities(Entities &entities, const size_t count, const uint32_t seed)
+{
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> position(-100.f, 100.f);
+    std::uniform_real_distribution<float> extent(0.1f, 8.f);
+
+    entities.resize(count);
+
+    const auto setups = entities.column<Entity::PhysicsSetup>();
+    const auto cStates = entities.column<Entity::PhysicsCartesianState>();
+    const auto boxes = entities.column<Entity::AABB>();
+    for (size_t i = 0; i < count; ++i) {
+        setups[i].isNotFixed = i % 4 == 0;
+        cStates[i].position = glm::vec2{position(random), position(random)};
+        boxes[i] = Entity::AABB{.min = {0.f, 0.f}, .max = {extent(random), extent(random)}};
+    }
+}
+
+/// @brief World bounds of entity @param i.
+auto boundsOf(const Entities &entities, const size_t i) -> Entity::AABB
+{
+    return Physics::worldBounds(entities.column<Entity::PhysicsCartesianState>()[i], entities.column<Entity::AABB>()[i]);
+}
+
+/// @brief Fixed entities overlapping @param bounds, scanning every entity.
+auto bruteForceQuery(const Entities &entities, const Entity::AABB &bounds) -> std::vector<int>
+{
+    std::vector<int> found{};
+    const auto setups = entities.column<Entity::PhysicsSetup>();
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (!setups[i].isNotFixed && boundsOf(entities, i).intersects(bounds)) {
+            found.push_back(static_cast<int>(i));
+        }
+    }
+    return found;
+}
+
+} // namespace
+
+TEST(StaticTree, StoresOnlyFixedEntities)
+{
+    Entities entities{};
+    fillEntities(entities, 1000, 1);
+    Physics::StaticTree tree{};
+    tree.build(entities);
+
+    EXPECT_EQ(tree.size(), 750u);
+    EXPECT_EQ(tree.builtFor(), 1000u);
+
+    tree.clear();
+    EXPECT_EQ(tree.size(), 0u);
+    tree.query(Entity::AABB{.min = {-1000.f, -1000.f}, .max = {1000.f, 1000.f}}, [](const int) -> void { FAIL(); });
+}
+
+TEST(StaticTree, QueryMatchesBruteForce)
+{
+    Entities entities{};
+    fillEntities(entities, 2000, 2);
+    Physics::StaticTree tree{};
+    tree.build(entities);
+
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> position(-110.f, 110.f);
+    std::uniform_real_distribution<float> extent(0.f, 30.f);
+
+    for (int q = 0; q < 500; ++q) {
+        const glm::vec2 min{position(random), position(random)};
+        const Entity::AABB bounds{.min = min, .max = min + glm::vec2{extent(random), extent(random)}};
+
+        std::vector<int> found{};
+        tree.query(bounds, [&found](const int i) -> void { found.push_back(i); });
+        std::ranges::sort(found);
+
+        EXPECT_EQ(found, bruteForceQuery(entities, bounds));
+    }
+}
+
+TEST(StaticTree, RaycastMatchesBruteForce)
+{
+    Entities entities{};
+    fillEntities(entities, 2000, 4);
+    const auto setups = entities.column<Entity::PhysicsSetup>();
+    Physics::StaticTree tree{};
+    tree.build(entities);
+
+    std::mt19937 random(5);
+    std::uniform_real_distribution<float> position(-120.f, 120.f);
+
+    for (int q = 0; q < 500; ++q) {
+        const glm::vec2 origin{position(random), position(random)};
+        const glm::vec2 delta = glm::vec2{position(random), position(random)} - origin;
+
+        // Every fixed entity whose bounds the segment crosses, and the closest one.
+        std::vector<int> expected{};
+        float closest = 1.f;
+        for (size_t i = 0; i < entities.size(); ++i) {
+            if (setups[i].isNotFixed) {
+                continue;
+            }
+            if (const auto fraction = Physics::rayAABB(origin, delta, boundsOf(entities, i), 1.f); fraction <= 1.f) {
+                expected.push_back(static_cast<int>(i));
+                closest = std::min(closest, fraction);
+            }
+        }
+
+        // Keeping the max fraction visits every crossed entity.
+        std::vector<int> crossed{};
+        tree.raycast(origin, delta, 1.f, [&crossed](const int i, const float maxFraction) -> float {
+            crossed.push_back(i);
+            return maxFraction;
+        });
+        std::ranges::sort(crossed);
+        EXPECT_EQ(crossed, expected);
+
+        // Shrinking it to each hit ends on the closest one.
+        float hit = 1.f;
+        tree.raycast(origin, delta, 1.f, [&entities, origin, delta, &hit](const int i, const float maxFraction) -> float {
+            hit = std::min(hit, Physics::rayAABB(origin, delta, boundsOf(entities, i), maxFraction));
+            return hit;
+        });
+        EXPECT_EQ(hit, closest);
+    }
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "src/world/snapshot.h"
+
+namespace
+{
+
+constexpr size_t entities = 256;
+
+/// @brief Fills @param snapshot as the snapshot of sequence @param sequence, every value derived from it.
+void fill(World::Snapshot &snapshot, const uint64_t sequence)
+{
+    const auto value = static_cast<float>(sequence);
+    for (size_t i = 0; i < snapshot.positions.size(); ++i) {
+        snapshot.positions[i] = glm::vec2{value, -value};
+        snapshot.previous[i] = glm::vec2{value - 1.f, static_cast<float>(i)};
+    }
+    snapshot.alpha = value;
+}
+
+/// @brief Returns true if @param snapshot holds exactly what @fn fill wrote for its sequence.
+auto isWhole(const World::Snapshot &snapshot) -> bool
+{
+    const auto value = static_cast<float>(snapshot.sequence);
+    if (snapshot.alpha != value || snapshot.positions.size() != entities || snapshot.previous.size() != entities) {
+        return false;
+    }
+    for (size_t i = 0; i < entities; ++i) {
+        if (snapshot.positions[i] != glm::vec2{value, -value} || snapshot.previous[i] != glm::vec2{value - 1.f, static_cast<float>(i)}) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(SnapshotBuffer, ConsumesOnlyNewSnapshots)
+{
+    World::SnapshotBuffer buffer{};
+    buffer.resize(entities);
+
+    EXPECT_FALSE(buffer.consume());
+
+    fill(buffer.back(), 0);
+    buffer.publish();
+    ASSERT_TRUE(buffer.consume());
+    EXPECT_EQ(buffer.front().sequence, 0u);
+    EXPECT_TRUE(isWhole(buffer.front()));
+    EXPECT_FALSE(buffer.consume());
+
+    // Only the newest of several publications is picked up.
+    for (uint64_t sequence = 1; sequence <= 3; ++sequence) {
+        fill(buffer.back(), sequence);
+        buffer.publish();
+    }
+    ASSERT_TRUE(buffer.consume());
+    EXPECT_EQ(buffer.front().sequence, 3u);
+    EXPECT_TRUE(isWhole(buffer.front()));
+    EXPECT_EQ(buffer.skipped(), 2u);
+    EXPECT_FALSE(buffer.consume());
+}
+
+TEST(SnapshotBuffer, ConcurrentProducerAndConsumer)
+{
+    constexpr uint64_t publications = 100000;
+
+    World::SnapshotBuffer buffer{};
+    buffer.resize(entities);
+    std::atomic<bool> done = false;
+
+    std::thread producer([&buffer, &done]() -> void {
+        for (uint64_t sequence = 0; sequence < publications; ++sequence) {
+            fill(buffer.back(), sequence);
+            buffer.publish();
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    // The consumer polls as the renderer does, the sequences must grow and no snapshot may mix two publications.
+    uint64_t consumed = 0;
+    uint64_t torn = 0;
+    uint64_t notIncreasing = 0;
+    uint64_t last = 0;
+    bool finished = false;
+    while (!finished) {
+        // Read before consuming, the last publication is then seen by the last consume.
+        finished = done.load(std::memory_order_acquire);
+        if (!buffer.consume()) {
+            continue;
+        }
+
+        const auto &snapshot = buffer.front();
+        notIncreasing += consumed > 0 && snapshot.sequence <= last ? 1 : 0;
+        torn += isWhole(snapshot) ? 0 : 1;
+        last = snapshot.sequence;
+        ++consumed;
+    }
+    producer.join();
+
+    EXPECT_EQ(torn, 0u);
+    EXPECT_EQ(notIncreasing, 0u);
+    EXPECT_EQ(last, publications - 1);
+    EXPECT_EQ(consumed + buffer.skipped(), publications);
+}
@@ -0,0 +1,99 @@
+#ifndef JP_TOOLS_PHYSBENCH_BENCH_H
+#define JP_TOOLS_PHYSBENCH_BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include "src/input/defines.h"
+#include "src/physics/defines.h"
+#include "src/physics/engine.h"
+#include "src/world/scene.h"
+
+namespace Bench
+{
+
+/**
+ * @brief Synthetic scene: moving unit boxes on a grid, above a ground made of fixed unit tiles.
+ * The same layout always builds the same scene.
+ */
+struct SceneLayout
+{
+    /// @brief Total number of entities.
+    size_t entities = 1000;
+    /// @brief Share of the entities that are fixed tiles.
+    float fixedShare = 0.25f;
+    /// @brief Distance between two moving boxes on the grid, a box being 1 unit wide.
+    float spacing = 1.5f;
+    /// @brief Seed of the positions and velocities jitter.
+    uint32_t seed = 1;
+    /// @brief Merges the tiles with Physics::mergeStaticBoxes, as the map loader does.
+    bool mergeTiles = false;
+};
+
+/// @brief Sets the world bounds and ids of the entities of @param scene, sizes its snapshots and builds its static tree.
+void finishScene(World::Scene &scene);
+
+/// @brief Builds the entities of @param layout as Loaders::Map::load2 does, without resources nor objects.
+auto makeScene(const SceneLayout &layout) -> std::shared_ptr<World::Scene>;
+
+/**
+ * @brief Engine set up on a synthetic scene, with the defaults of the game and no input.
+ * The level of detail is disabled, every moving entity is simulated at every step.
+ */
+class Simulation
+{
+public:
+    explicit Simulation(const SceneLayout &layout);
+    /// @brief Simulates @param simulated, built by the benchmark itself.
+    explicit Simulation(std::shared_ptr<World::Scene> simulated);
+
+    /// @brief Runs @param steps steps of @param timeDelta.
+    void run(size_t steps, double timeDelta = Physics::timestep());
+
+    /// @brief Input state read by the engine, never pressed.
+    Input::State input{};
+    /// @brief Scene simulated.
+    std::shared_ptr<World::Scene> scene = nullptr;
+    /// @brief Engine simulating @var scene.
+    Physics::Engine engine{};
+};
+
+/// @brief Wall time taken by @param fn, in milliseconds.
+template<typename F>
+auto measureMs(F &&fn) -> double
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief Keeps the compiler from removing the computation of @param value.
+template<typename T>
+void keep(const T &value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+/* Benchmarks, each one prints its results and returns the exit code of the program */
+
+/// @brief Candidate pairs and tick time of each broad phase on 1k, 10k and 50k entities.
+auto broadPhase() -> int;
+/// @brief Time per step of the batched and RK4 integrators on 10k bodies.
+auto integrator() -> int;
+/// @brief SAT pairs per second of Physics::projectPolygon built for each instruction set.
+auto projection() -> int;
+/// @brief Narrow phase time with 1 to N threads, checking the resulting states are identical.
+auto threads() -> int;
+/// @brief Penetration and sleeping bodies of the maps/stack scene over time, at several tick rates.
+auto stack() -> int;
+/// @brief Queries per second of the raycasts and overlap queries on 10k entities.
+auto queries() -> int;
+/// @brief Resident memory of 10k tiles with pooled shapes and with per-entity outline copies.
+auto memory() -> int;
+/// @brief Pairs per second of each narrow phase kernel, and of the generic SAT test on the same pairs.
+auto kernels() -> int;
+
+} // namespace Bench
+
+#endif // JP_TOOLS_PHYSBENCH_BENCH_H
@@ -0,0 +1,61 @@
+#include "tools/physbench/bench.h"
+
+#include <cstdio>
+
+#include <magic_enum.hpp>
+
+namespace Bench
+{
+
+auto broadPhase() -> int
+{
+    constexpr size_t sizes[] = {1000, 10000, 50000};
+    constexpr size_t warmUpSteps = 10;
+    constexpr size_t measuredSteps = 60;
+    // Every pair is tested, a step of 50k entities takes seconds.
+    constexpr size_t bruteForceLimit = 10000;
+
+    std::printf("%-14s %8s %14s %12s %13s %10s\n", "broad phase", "entities", "candidatePairs", "broadPhaseMs", "narrowPhaseMs", "tickMs");
+
+    for (const auto size : sizes) {
+        for (auto value = static_cast<int>(Physics::BroadPhase::First); value <= static_cast<int>(Physics::BroadPhase::Last); ++value) {
+            const auto broadPhase = static_cast<Physics::BroadPhase>(value);
+            const auto name = magic_enum::enum_name(broadPhase);
+            if (broadPhase == Physics::BroadPhase::BruteForce && size > bruteForceLimit) {
+                std::printf("%-14.*s %8zu %14s\n", static_cast<int>(name.size()), name.data(), size, "skipped");
+                continue;
+            }
+
+            Simulation simulation(SceneLayout{.entities = size});
+            simulation.engine.setBroadPhase(broadPhase);
+            simulation.run(warmUpSteps);
+
+            // Averages of the measured steps.
+            double pairs = 0.;
+            double broadPhaseMs = 0.;
+            double narrowPhaseMs = 0.;
+            double tickMs = 0.;
+            for (size_t i = 0; i < measuredSteps; ++i) {
+                simulation.run(1);
+                const auto &stats = simulation.engine.stats();
+                pairs += static_cast<double>(stats.candidatePairs);
+                broadPhaseMs += stats.broadPhaseMs;
+                narrowPhaseMs += stats.narrowPhaseMs;
+                tickMs += stats.tickMs;
+            }
+
+            std::printf("%-14.*s %8zu %14.0f %12.3f %13.3f %10.3f\n",
+                        static_cast<int>(name.size()),
+                        name.data(),
+                        size,
+                        pairs / measuredSteps,
+                        broadPhaseMs / measuredSteps,
+                        narrowPhaseMs / measuredSteps,
+                        tickMs / measuredSteps);
+        }
+    }
+
+    return 0;
+}
+
+} // namespace Bench
@@ -0,0 +1,81 @@
+#include "tools/physbench/bench.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "src/physics/defines.h"
+#include "src/physics/entity.h"
+#include "src/physics/integrator.h"
+
+namespace Bench
+{
+
+namespace
+{
+
+constexpr size_t bodies = 10000;
+constexpr size_t steps = 200;
+
+/// @brief Force pushed on every body before each step, both paths read and clear it.
+constexpr glm::vec2 push{0.5f, 0.f};
+
+void applyPush(World::Scene &scene)
+{
+    for (auto &forces : scene.dynamicColumn<Entity::PhysicsForces>()) {
+        forces.add(push);
+    }
+}
+
+} // namespace
+
+auto integrator() -> int
+{
+    const SceneLayout layout{.entities = bodies, .fixedShare = 0.f};
+    const auto timeDelta = static_cast<double>(Physics::timestep());
+
+    // Structure-of-arrays semi-implicit Euler, the default.
+    const auto soaScene = makeScene(layout);
+    Physics::Integrator batched{};
+    const auto soaMs = measureMs([&soaScene, &batched, timeDelta]() -> void {
+        for (size_t i = 0; i < steps; ++i) {
+            applyPush(*soaScene);
+            batched.integrate(soaScene->entities, soaScene->dynamicCount, timeDelta);
+        }
+    });
+
+    // Per-entity boost::odeint RK4, as built with PHYSICS_RK4.
+    const auto rk4Scene = makeScene(layout);
+    const auto rk4Ms = measureMs([&rk4Scene, timeDelta]() -> void {
+        const auto cStates = rk4Scene->dynamicColumn<Entity::PhysicsCartesianState>();
+        const auto aStates = rk4Scene->dynamicColumn<Entity::PhysicsAngularState>();
+        const auto setups = rk4Scene->dynamicColumn<Entity::PhysicsSetup>();
+        const auto forces = rk4Scene->dynamicColumn<Entity::PhysicsForces>();
+        const auto constraints = rk4Scene->dynamicColumn<Entity::PhysicsConstraints>();
+
+        for (size_t i = 0; i < steps; ++i) {
+            applyPush(*rk4Scene);
+            for (size_t b = 0; b < cStates.size(); ++b) {
+                Physics::compute(timeDelta, ReferencesSet{cStates[b], aStates[b], setups[b], forces[b], constraints[b]});
+            }
+        }
+    });
+
+    // Both solve the same model, the RK4 path storing the integrated velocity as the acceleration.
+    float maxDistance = 0.f;
+    const auto soaStates = soaScene->dynamicColumn<Entity::PhysicsCartesianState>();
+    const auto rk4States = rk4Scene->dynamicColumn<Entity::PhysicsCartesianState>();
+    for (size_t b = 0; b < soaStates.size(); ++b) {
+        maxDistance = std::max(maxDistance, glm::length(soaStates[b].position - rk4States[b].position));
+    }
+
+    const auto bodySteps = static_cast<double>(bodies * steps);
+    std::printf("%zu bodies, %zu steps of %g s\n", bodies, steps, timeDelta);
+    std::printf("%-6s %12s %16s\n", "path", "ms/step", "bodies/s");
+    std::printf("%-6s %12.4f %16.0f\n", "SoA", soaMs / steps, bodySteps / (soaMs / 1000.));
+    std::printf("%-6s %12.4f %16.0f\n", "RK4", rk4Ms / steps, bodySteps / (rk4Ms / 1000.));
+    std::printf("RK4/SoA time ratio %.2f, largest position difference %g\n", rk4Ms / soaMs, maxDistance);
+
+    return 0;
+}
+
+} // namespace Bench
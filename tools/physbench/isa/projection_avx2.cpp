@@ -0,0 +1,4 @@
+// Physics::projectPolygon built for AVX2, as Physics::projectPolygonAvx2, benchmarked by tools/physbench/projection.cpp.
+#define projectPolygon projectPolygonAvx2
+#define projectionBatch projectionBatchAvx2
+#include "src/physics/projection.cpp"
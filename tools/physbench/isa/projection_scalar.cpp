@@ -0,0 +1,5 @@
+// Physics::projectPolygon built with the scalar fallback, as Physics::projectPolygonScalar, benchmarked by tools/physbench/projection.cpp.
+#define JP_PROJECTION_SCALAR
+#define projectPolygon projectPolygonScalar
+#define projectionBatch projectionBatchScalar
+#include "src/physics/projection.cpp"
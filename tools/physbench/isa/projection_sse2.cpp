@@ -0,0 +1,4 @@
+// Physics::projectPolygon built for SSE2, as Physics::projectPolygonSse2, benchmarked by tools/physbench/projection.cpp.
+#define projectPolygon projectPolygonSse2
+#define projectionBatch projectionBatchSse2
+#include "src/physics/projection.cpp"
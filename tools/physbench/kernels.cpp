@@ -0,0 +1,130 @@
+#include "tools/physbench/bench.h"
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <numbers>
+#include <span>
+#include <vector>
+
+#include "src/config.h"
+#include "src/physics/kernels.h"
+#include "src/physics/outline.h"
+
+namespace Bench
+{
+
+namespace
+{
+
+/// @brief Pairs of parts tested by one row of the benchmark.
+struct KernelCase
+{
+    /// @brief Kinds of the pair.
+    const char *name;
+    /// @brief Kernel tested, either the one of the kinds in Physics::pairKernels or the generic SAT test.
+    Physics::PairKernel kernel;
+    /// @brief Shape of the first part.
+    uint32_t a;
+    /// @brief Shape of the second part.
+    uint32_t b;
+};
+
+/// @brief Counters of a run of a kernel over every offset.
+struct KernelRun
+{
+    size_t contacts = 0;
+    size_t axesTested = 0;
+};
+
+auto runKernel(const KernelCase &test, const Physics::ShapePool &shapes, const std::span<const glm::vec2> offsets) -> KernelRun
+{
+    KernelRun run{};
+    const Physics::PlacedShape a{.shape = shapes.shape(test.a)};
+    Physics::PlacedShape b{.shape = shapes.shape(test.b)};
+    Entity::CollisionInfo info{};
+    Physics::SeparatingAxis separating{};
+
+    for (const auto offset : offsets) {
+        b.position = offset;
+        run.contacts += test.kernel(a, b, info, separating, run.axesTested, nullptr) ? 1 : 0;
+    }
+    keep(info);
+    keep(separating);
+
+    return run;
+}
+
+} // namespace
+
+auto kernels() -> int
+{
+    constexpr size_t pairs = 1 << 22;
+
+    // Unit box, and an octagon inscribed in the unit square, its opposite borders giving 4 axes.
+    Physics::ShapePool shapes{};
+    constexpr std::array<glm::vec2, 5> boxBorders{{{0.f, 0.f}, {0.f, 1.f}, {1.f, 1.f}, {1.f, 0.f}, {0.f, 0.f}}};
+    constexpr std::array<glm::vec2, 4> boxNormals{{{-1.f, 0.f}, {0.f, 1.f}, {1.f, 0.f}, {0.f, -1.f}}};
+    const auto box = shapes.intern(boxBorders, boxNormals);
+
+    std::vector<glm::vec2> octagon{};
+    for (int i = 0; i < 8; ++i) {
+        const auto angle = std::numbers::pi_v<float> / 8.f + static_cast<float>(i) * std::numbers::pi_v<float> / 4.f;
+        octagon.emplace_back(0.5f + 0.5f * std::cos(angle), 0.5f + 0.5f * std::sin(angle));
+    }
+    const auto octagonNormals = Physics::convexNormals(octagon, Config::outlineAngleTolerance);
+    const auto convex = shapes.intern(octagon, octagonNormals);
+
+    if (shapes.kind(box) != Physics::ShapeKind::Box || shapes.kind(convex) != Physics::ShapeKind::Convex) {
+        std::printf("The benchmark shapes were not interned as a box and a convex polygon\n");
+        return 1;
+    }
+
+    const auto kernelOf = [&shapes](const uint32_t a, const uint32_t b) -> Physics::PairKernel {
+        return Physics::pairKernels[static_cast<size_t>(shapes.kind(a))][static_cast<size_t>(shapes.kind(b))];
+    };
+    // The generic rows run the full SAT test on the same pairs, the cost of the kernels before they were specialized.
+    const KernelCase cases[] = {
+        {"Box/Box", kernelOf(box, box), box, box},
+        {"Box/Box generic", Physics::convexConvex, box, box},
+        {"Box/Convex", kernelOf(box, convex), box, convex},
+        {"Box/Convex generic", Physics::convexConvex, box, convex},
+        {"Convex/Convex", kernelOf(convex, convex), convex, convex},
+    };
+
+    // Around the first part, half of the pairs overlap.
+    std::vector<glm::vec2> offsets(1024);
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        const auto angle = static_cast<float>(i) * 0.37f;
+        offsets[i] = glm::vec2{std::cos(angle), std::sin(angle)} * (i % 2 == 0 ? 0.6f : 1.6f);
+    }
+
+    std::printf("%zu pairs per kernel, unit box and octagon of %zu axes\n", pairs, octagonNormals.size());
+    std::printf("%-19s %14s %10s %10s %12s\n", "kernel", "pairs/s", "ns/pair", "axes/pair", "colliding %");
+
+    for (const auto &test : cases) {
+        // Warm up.
+        runKernel(test, shapes, offsets);
+
+        KernelRun total{};
+        const auto ms = measureMs([&]() -> void {
+            for (size_t done = 0; done < pairs; done += offsets.size()) {
+                const auto run = runKernel(test, shapes, offsets);
+                total.contacts += run.contacts;
+                total.axesTested += run.axesTested;
+            }
+        });
+        keep(total);
+
+        std::printf("%-19s %14.0f %10.2f %10.2f %12.1f\n",
+                    test.name,
+                    static_cast<double>(pairs) / (ms / 1000.),
+                    ms * 1e6 / static_cast<double>(pairs),
+                    static_cast<double>(total.axesTested) / static_cast<double>(pairs),
+                    100. * static_cast<double>(total.contacts) / static_cast<double>(pairs));
+    }
+
+    return 0;
+}
+
+} // namespace Bench
@@ -0,0 +1,123 @@
+#include "tools/physbench/bench.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include <unistd.h>
+
+namespace Bench
+{
+
+namespace
+{
+
+/// @brief Resident set size of the process in bytes, 0 when /proc is not available.
+auto residentBytes() -> size_t
+{
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0;
+    size_t resident = 0;
+    if (!(statm >> pages >> resident)) {
+        return 0;
+    }
+    return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+/// @brief Outline of an entity as each entity stored it before the shapes were pooled.
+struct OutlineCopy
+{
+    std::vector<glm::vec2> borders{};
+    std::vector<glm::vec2> normals{};
+    std::vector<float> xs{};
+    std::vector<float> ys{};
+};
+
+/// @brief Projects every outline on its first normal, as the SAT test reads them, returns the sum of the extents.
+template<typename F>
+auto projectAll(const size_t count, F &&outline) -> float
+{
+    float sum = 0.f;
+    for (size_t i = 0; i < count; ++i) {
+        const auto &[xs, ys, normals] = outline(i);
+        float lo = std::numeric_limits<float>::max();
+        float hi = std::numeric_limits<float>::lowest();
+        for (size_t p = 0; p < xs.size(); ++p) {
+            const auto d = xs[p] * normals[0].x + ys[p] * normals[0].y;
+            lo = std::min(lo, d);
+            hi = std::max(hi, d);
+        }
+        sum += hi - lo;
+    }
+    return sum;
+}
+
+void printMemory(const char *stage, const size_t bytes, const size_t baseline)
+{
+    std::printf("%-28s %12zu %12zd\n", stage, bytes / 1024, (static_cast<ssize_t>(bytes) - static_cast<ssize_t>(baseline)) / 1024);
+}
+
+} // namespace
+
+auto memory() -> int
+{
+    constexpr size_t tiles = 10000;
+    constexpr size_t passes = 100;
+
+    // No moving entity, a square of 100x100 tiles.
+    const auto start = residentBytes();
+    const auto scene = makeScene(SceneLayout{.entities = tiles, .fixedShare = 1.f, .spacing = 100.f});
+    const auto pooled = residentBytes();
+
+    const auto bounds = scene->entities.column<Entity::PhysicsBounds>();
+    std::vector<OutlineCopy> copies(bounds.size());
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        const auto shape = scene->shapes.shape(bounds[i].shape);
+        copies[i] = OutlineCopy{
+            .borders = {shape.borders.begin(), shape.borders.end()},
+            .normals = {shape.normals.begin(), shape.normals.end()},
+            .xs = {shape.xs.begin(), shape.xs.end()},
+            .ys = {shape.ys.begin(), shape.ys.end()},
+        };
+    }
+    const auto copied = residentBytes();
+
+    std::printf("%zu tiles, %zu shapes, pool of %zu bytes\n", tiles, scene->shapes.size(), scene->shapes.memoryBytes());
+    std::printf("%-28s %12s %12s\n", "stage", "RSS KiB", "delta KiB");
+    printMemory("start", start, start);
+    printMemory("scene, pooled shapes", pooled, start);
+    printMemory("plus per-entity copies", copied, pooled);
+
+    // The same outlines read from the pool and from the copies.
+    float pooledSum = 0.f;
+    const auto pooledMs = measureMs([&]() -> void {
+        for (size_t pass = 0; pass < passes; ++pass) {
+            pooledSum += projectAll(tiles, [&](const size_t i) -> auto {
+                const auto shape = scene->shapes.shape(bounds[i].shape);
+                return std::tuple{shape.xs, shape.ys, shape.normals};
+            });
+        }
+    });
+    float copiesSum = 0.f;
+    const auto copiesMs = measureMs([&]() -> void {
+        for (size_t pass = 0; pass < passes; ++pass) {
+            copiesSum += projectAll(tiles, [&](const size_t i) -> auto {
+                return std::tuple{std::span<const float>(copies[i].xs), std::span<const float>(copies[i].ys), std::span<const glm::vec2>(copies[i].normals)};
+            });
+        }
+    });
+    keep(pooledSum);
+    keep(copiesSum);
+
+    std::printf("%-28s %12s\n", "outlines read", "ms/pass");
+    std::printf("%-28s %12.4f\n", "pooled", pooledMs / passes);
+    std::printf("%-28s %12.4f\n", "per-entity copies", copiesMs / passes);
+
+    return pooledSum == copiesSum ? 0 : 1;
+}
+
+} // namespace Bench
@@ -0,0 +1,162 @@
+#include "tools/physbench/bench.h"
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <numbers>
+#include <span>
+#include <vector>
+
+namespace Physics
+{
+
+/* Physics::projectPolygon built once per instruction set, see tools/physbench/isa */
+
+void projectPolygonScalar(std::span<const float> xs,
+                          std::span<const float> ys,
+                          glm::vec2 offset,
+                          glm::vec2 scale,
+                          std::span<const glm::vec2> axes,
+                          float *mins,
+                          float *maxs) noexcept;
+#if defined(JP_PHYSBENCH_X86)
+void projectPolygonSse2(std::span<const float> xs,
+                        std::span<const float> ys,
+                        glm::vec2 offset,
+                        glm::vec2 scale,
+                        std::span<const glm::vec2> axes,
+                        float *mins,
+                        float *maxs) noexcept;
+void projectPolygonAvx2(std::span<const float> xs,
+                        std::span<const float> ys,
+                        glm::vec2 offset,
+                        glm::vec2 scale,
+                        std::span<const glm::vec2> axes,
+                        float *mins,
+                        float *maxs) noexcept;
+#endif
+
+} // namespace Physics
+
+namespace Bench
+{
+
+namespace
+{
+
+/// @brief Signature of Physics::projectPolygon.
+using ProjectFn = void (*)(std::span<const float>, std::span<const float>, glm::vec2, glm::vec2, std::span<const glm::vec2>, float *, float *) noexcept;
+
+/// @brief Build of the projection kernel.
+struct Kernel
+{
+    /// @brief Instruction set the kernel was built for.
+    const char *name;
+    /// @brief Axes projected per call, Physics::projectionBatch of that build.
+    size_t batch;
+    /// @brief Kernel.
+    ProjectFn project;
+};
+
+/// @brief Regular polygon of @param sides vertices and its edge normals, the polygons of the Convex kind.
+struct Polygon
+{
+    std::vector<float> xs{};
+    std::vector<float> ys{};
+    std::vector<glm::vec2> normals{};
+
+    explicit Polygon(const size_t sides, const float phase)
+    {
+        for (size_t i = 0; i < sides; ++i) {
+            const auto angle = phase + 2.f * std::numbers::pi_v<float> * static_cast<float>(i) / static_cast<float>(sides);
+            const auto next = angle + 2.f * std::numbers::pi_v<float> / static_cast<float>(sides);
+            xs.push_back(std::cos(angle));
+            ys.push_back(std::sin(angle));
+            normals.push_back(glm::normalize(glm::vec2{std::cos((angle + next) / 2.f), std::sin((angle + next) / 2.f)}));
+        }
+    }
+};
+
+/**
+ * @brief Runs the SAT test of @param a against @param b placed at each of @param offsets, projecting both on every
+ * normal of both.
+ * @return Number of pairs found separated.
+ */
+auto satPairs(const Kernel &kernel, const Polygon &a, const Polygon &b, std::span<const glm::vec2> offsets) -> size_t
+{
+    std::vector<glm::vec2> axes = a.normals;
+    axes.insert(axes.end(), b.normals.begin(), b.normals.end());
+
+    std::array<float, 8> aMin{};
+    std::array<float, 8> aMax{};
+    std::array<float, 8> bMin{};
+    std::array<float, 8> bMax{};
+
+    size_t separated = 0;
+    for (const auto offset : offsets) {
+        bool apart = false;
+        for (size_t first = 0; first < axes.size() && !apart; first += kernel.batch) {
+            const auto batch = std::span<const glm::vec2>(axes).subspan(first, std::min(kernel.batch, axes.size() - first));
+            kernel.project(a.xs, a.ys, glm::vec2{}, glm::vec2{1.f, 1.f}, batch, aMin.data(), aMax.data());
+            kernel.project(b.xs, b.ys, offset, glm::vec2{1.f, 1.f}, batch, bMin.data(), bMax.data());
+            for (size_t k = 0; k < batch.size(); ++k) {
+                apart = apart || aMax[k] < bMin[k] || bMax[k] < aMin[k];
+            }
+        }
+        separated += apart ? 1 : 0;
+    }
+
+    return separated;
+}
+
+} // namespace
+
+auto projection() -> int
+{
+    const Kernel kernels[] = {
+        {"scalar", 4, Physics::projectPolygonScalar},
+#if defined(JP_PHYSBENCH_X86)
+        {"SSE2", 4, Physics::projectPolygonSse2},
+        {"AVX2", 8, Physics::projectPolygonAvx2},
+#endif
+    };
+    constexpr size_t sides = 8;
+    constexpr size_t pairs = 1 << 20;
+
+    // Half of the pairs overlap, the others are separated by the last axes tested.
+    const Polygon a(sides, 0.f);
+    const Polygon b(sides, 0.3f);
+    std::vector<glm::vec2> offsets(1024);
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        const auto angle = static_cast<float>(i) * 0.37f;
+        offsets[i] = glm::vec2{std::cos(angle), std::sin(angle)} * (i % 2 == 0 ? 1.5f : 2.5f);
+    }
+
+    std::printf("%zu-gons, %zu axes per pair, %zu pairs\n", sides, 2 * sides, pairs);
+    std::printf("%-7s %6s %16s %14s\n", "kernel", "batch", "SAT pairs/s", "ns/projection");
+
+    for (const auto &kernel : kernels) {
+        // Warm up, then check the kernel finds the same pairs as the scalar one.
+        const auto separated = satPairs(kernel, a, b, offsets);
+        if (separated != satPairs(kernels[0], a, b, offsets)) {
+            std::printf("%s separates %zu pairs, the scalar kernel does not\n", kernel.name, separated);
+            return 1;
+        }
+
+        size_t total = 0;
+        const auto ms = measureMs([&]() -> void {
+            for (size_t done = 0; done < pairs; done += offsets.size()) {
+                total += satPairs(kernel, a, b, offsets);
+            }
+        });
+        keep(total);
+
+        // Both polygons are projected once per batch of axes, separated pairs stopping early are counted as full ones.
+        const auto projections = static_cast<double>(pairs) * 2. * std::ceil(2. * sides / static_cast<double>(kernel.batch));
+        std::printf("%-7s %6zu %16.0f %14.2f\n", kernel.name, kernel.batch, static_cast<double>(pairs) / (ms / 1000.), ms * 1e6 / projections);
+    }
+
+    return 0;
+}
+
+} // namespace Bench
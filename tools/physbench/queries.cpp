@@ -0,0 +1,98 @@
+#include "tools/physbench/bench.h"
+
+#include <array>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "src/physics/query.h"
+
+namespace Bench
+{
+
+namespace
+{
+
+constexpr size_t queryCount = 100000;
+
+/// @brief Prints one line of results, @param found being the number of hits or entities found.
+void printQueries(const char *name, const double ms, const size_t found)
+{
+    std::printf("%-14s %10.3f %16.0f %10zu\n", name, ms, static_cast<double>(queryCount) / (ms / 1000.), found);
+}
+
+} // namespace
+
+auto queries() -> int
+{
+    Simulation simulation(SceneLayout{.entities = 10000});
+    // The moving boxes leave the grid, the queries run on a scene that was stepped.
+    simulation.run(30);
+    const auto &engine = simulation.engine;
+
+    // Queries spread over the scene: the grid of moving boxes above the ground, the ground going down from y = 0.
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> x(-10.f, 140.f);
+    std::uniform_real_distribution<float> y(-25.f, 140.f);
+    std::uniform_real_distribution<float> length(-20.f, 20.f);
+    std::uniform_real_distribution<float> extent(0.5f, 4.f);
+
+    std::vector<Physics::RayQuery> rays(queryCount);
+    std::vector<Entity::AABB> boxes(queryCount);
+    std::vector<glm::vec2> points(queryCount);
+    for (size_t i = 0; i < queryCount; ++i) {
+        rays[i] = Physics::RayQuery{.origin = {x(random), y(random)}, .delta = {length(random), length(random)}};
+        const glm::vec2 min{x(random), y(random)};
+        boxes[i] = Entity::AABB{.min = min, .max = min + glm::vec2{extent(random), extent(random)}};
+        points[i] = glm::vec2{x(random), y(random)};
+    }
+
+    std::printf("%zu entities, %zu queries of each kind\n", simulation.scene->entities.size(), queryCount);
+    std::printf("%-14s %10s %16s %10s\n", "query", "ms", "queries/s", "found");
+
+    std::vector<Physics::RayHit> batchedHits(queryCount);
+    size_t batchedCount = 0;
+    const auto batchedMs = measureMs([&]() -> void { batchedCount = engine.raycast(rays, batchedHits); });
+    printQueries("raycast batch", batchedMs, batchedCount);
+
+    std::vector<Physics::RayHit> singleHits(queryCount);
+    size_t singleCount = 0;
+    const auto singleMs = measureMs([&]() -> void {
+        for (size_t i = 0; i < queryCount; ++i) {
+            singleCount += engine.raycast(rays[i], singleHits[i]) ? 1 : 0;
+        }
+    });
+    printQueries("raycast", singleMs, singleCount);
+
+    // Only the number of entities found is kept, as a caller reading the first ones would.
+    std::array<int, 64> found{};
+    size_t aabbCount = 0;
+    const auto aabbMs = measureMs([&]() -> void {
+        for (const auto &box : boxes) {
+            aabbCount += engine.overlapAABB(box, found);
+        }
+    });
+    keep(found);
+    printQueries("overlapAABB", aabbMs, aabbCount);
+
+    size_t pointCount = 0;
+    const auto pointMs = measureMs([&]() -> void {
+        for (const auto point : points) {
+            pointCount += engine.overlapPoint(point, found);
+        }
+    });
+    keep(found);
+    printQueries("overlapPoint", pointMs, pointCount);
+
+    // Both raycasts must find the same entities.
+    for (size_t i = 0; i < queryCount; ++i) {
+        if (batchedHits[i].entity != singleHits[i].entity || batchedHits[i].fraction != singleHits[i].fraction) {
+            std::printf("Ray %zu hits entity %d in the batch, %d alone\n", i, batchedHits[i].entity, singleHits[i].entity);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace Bench
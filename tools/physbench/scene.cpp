@@ -0,0 +1,111 @@
+#include "tools/physbench/bench.h"
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "src/physics/defines.h"
+#include "src/physics/entity.h"
+#include "src/physics/tilemerge.h"
+
+namespace Bench
+{
+
+void finishScene(World::Scene &scene)
+{
+    /* World bounds and ids, as the loader sets them */ {
+        const auto states = scene.entities.column<Entity::PhysicsCartesianState>();
+        const auto aabbs = scene.entities.column<Entity::AABB>();
+        const auto world = scene.entities.column<Entity::WorldAABB>();
+        const auto objStates = scene.entities.column<Entity::PhysicsObjectState>();
+        for (size_t i = 0; i < world.size(); ++i) {
+            world[i].bounds = Physics::worldBounds(states[i], aabbs[i]);
+            objStates[i].id = static_cast<uint32_t>(i);
+        }
+    }
+
+    scene.snapshots.resize(scene.dynamicCount);
+    scene.staticTree.build(scene.entities);
+}
+
+auto makeScene(const SceneLayout &layout) -> std::shared_ptr<World::Scene>
+{
+    std::vector<Graphics::Chunk> chunks{};
+    auto scene = std::make_shared<World::Scene>(chunks);
+
+    const auto fixedCount = static_cast<size_t>(static_cast<float>(layout.entities) * layout.fixedShare);
+    const auto movingCount = layout.entities - fixedCount;
+
+    // Same unit square as the outlines of opaque images, see ImageVectorizer.
+    constexpr std::array<glm::vec2, 5> unitBorders{{{0.f, 0.f}, {0.f, 1.f}, {1.f, 1.f}, {1.f, 0.f}, {0.f, 0.f}}};
+    constexpr std::array<glm::vec2, 4> unitNormals{{{-1.f, 0.f}, {0.f, 1.f}, {1.f, 0.f}, {0.f, -1.f}}};
+    const auto unitBox = scene->shapes.intern(unitBorders, unitNormals);
+
+    scene->entities.resize(layout.entities);
+    scene->dynamicCount = movingCount;
+
+    const auto setups = scene->entities.column<Entity::PhysicsSetup>();
+    const auto cStates = scene->entities.column<Entity::PhysicsCartesianState>();
+    const auto bounds = scene->entities.column<Entity::PhysicsBounds>();
+    const auto boxes = scene->entities.column<Entity::AABB>();
+
+    // Moving boxes fill a square above the ground, the ground is as wide as the square.
+    const auto columns = std::max<size_t>(1, static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(movingCount)))));
+    const auto groundWidth = std::max<size_t>(1, static_cast<size_t>(std::ceil(static_cast<float>(columns) * layout.spacing)));
+
+    std::mt19937 random(layout.seed);
+    std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+    std::uniform_real_distribution<float> speed(-2.f, 2.f);
+
+    for (size_t i = 0; i < layout.entities; ++i) {
+        const bool moving = i < movingCount;
+
+        setups[i].isNotFixed = moving;
+        bounds[i] = Entity::PhysicsBounds{.shape = unitBox};
+        boxes[i] = Entity::AABB{.min = {0.f, 0.f}, .max = {1.f, 1.f}};
+
+        if (moving) {
+            const auto column = static_cast<float>(i % columns);
+            const auto row = static_cast<float>(i / columns);
+            cStates[i].position = glm::vec2{column * layout.spacing + jitter(random), 2.f + row * layout.spacing + jitter(random)};
+            cStates[i].velocity = glm::vec2{speed(random), speed(random)};
+        } else {
+            // Rows of touching tiles, going down from y = 0.
+            const auto tile = i - movingCount;
+            cStates[i].position = glm::vec2{static_cast<float>(tile % groundWidth), -static_cast<float>(tile / groundWidth)};
+        }
+    }
+
+    if (layout.mergeTiles) {
+        const auto report = Physics::mergeStaticBoxes(scene->entities, scene->dynamicCount, scene->shapes);
+        scene->firstMergedEntity = report.firstMerged;
+    }
+
+    finishScene(*scene);
+
+    return scene;
+}
+
+Simulation::Simulation(const SceneLayout &layout)
+    : Simulation(makeScene(layout))
+{
+}
+
+Simulation::Simulation(std::shared_ptr<World::Scene> simulated)
+    : scene(std::move(simulated))
+{
+    engine.setScene(scene);
+    engine.setInputState(input);
+    engine.setLevelOfDetail(false);
+}
+
+void Simulation::run(const size_t steps, const double timeDelta)
+{
+    for (size_t i = 0; i < steps; ++i) {
+        engine.step(timeDelta);
+    }
+}
+
+} // namespace Bench
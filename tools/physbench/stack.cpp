@@ -0,0 +1,98 @@
+#include "tools/physbench/bench.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <vector>
+
+#include "src/config.h"
+
+namespace Bench
+{
+
+namespace
+{
+
+constexpr float boxSize = 4.f;
+constexpr size_t floorBoxes = 5;
+constexpr size_t stackedBoxes = 8;
+
+/// @brief Same entities as maps/stack: a floor of fixed 4x4 boxes and a column of moving ones dropped on its middle.
+auto makeStack() -> std::shared_ptr<World::Scene>
+{
+    std::vector<Graphics::Chunk> chunks{};
+    auto scene = std::make_shared<World::Scene>(chunks);
+
+    // The outline of the box resource once scaled to its size.
+    constexpr std::array<glm::vec2, 5> borders{{{0.f, 0.f}, {0.f, boxSize}, {boxSize, boxSize}, {boxSize, 0.f}, {0.f, 0.f}}};
+    constexpr std::array<glm::vec2, 4> normals{{{-1.f, 0.f}, {0.f, 1.f}, {1.f, 0.f}, {0.f, -1.f}}};
+    const auto box = scene->shapes.intern(borders, normals);
+
+    scene->entities.resize(stackedBoxes + floorBoxes);
+    scene->dynamicCount = stackedBoxes;
+
+    const auto setups = scene->entities.column<Entity::PhysicsSetup>();
+    const auto cStates = scene->entities.column<Entity::PhysicsCartesianState>();
+    const auto bounds = scene->entities.column<Entity::PhysicsBounds>();
+    const auto boxes = scene->entities.column<Entity::AABB>();
+
+    for (size_t i = 0; i < scene->entities.size(); ++i) {
+        const bool moving = i < stackedBoxes;
+
+        setups[i].isNotFixed = moving;
+        bounds[i] = Entity::PhysicsBounds{.shape = box};
+        boxes[i] = Entity::AABB{.min = {0.f, 0.f}, .max = {boxSize, boxSize}};
+        cStates[i].position = moving ? glm::vec2{0.f, boxSize * static_cast<float>(i + 1)}
+                                     : glm::vec2{boxSize * (static_cast<float>(i - stackedBoxes) - 2.f), 0.f};
+    }
+
+    finishScene(*scene);
+
+    return scene;
+}
+
+} // namespace
+
+auto stack() -> int
+{
+    constexpr std::array<int, 3> ticks{Config::simTick, Config::simTick / 2, Config::simTick / 4};
+    // Seconds of real time, the stack lands in the first one and falls asleep after Config::sleepTicks steps at rest.
+    constexpr std::array<float, 5> checkpoints{0.5f, 1.f, 2.f, 4.f, 8.f};
+
+    std::printf("%zu boxes stacked on %zu fixed ones, %d steps per tick, %u solver iterations\n",
+                stackedBoxes,
+                floorBoxes,
+                Config::simMultiplier,
+                Config::solverIterations);
+    std::printf("%7s %8s %15s %14s %10s\n", "simTick", "seconds", "maxPenetration", "sleepingBodies", "solverMs");
+
+    for (const auto tick : ticks) {
+        Simulation simulation(makeStack());
+        const auto timeDelta = 1. / tick / Config::simMultiplier * Config::simSpeed;
+
+        // Deepest penetration and solver time since the previous checkpoint, bodies asleep at the checkpoint.
+        size_t step = 0;
+        for (const auto seconds : checkpoints) {
+            const auto last = static_cast<size_t>(seconds * static_cast<float>(tick * Config::simMultiplier));
+            float maxPenetration = 0.f;
+            double solverMs = 0.;
+            const auto first = step;
+            for (; step < last; ++step) {
+                simulation.run(1, timeDelta);
+                maxPenetration = std::max(maxPenetration, simulation.engine.stats().maxPenetration);
+                solverMs += simulation.engine.stats().solverMs;
+            }
+
+            std::printf("%7d %8.1f %15.4f %14zu %10.4f\n",
+                        tick,
+                        seconds,
+                        maxPenetration,
+                        simulation.engine.stats().sleepingBodies,
+                        solverMs / static_cast<double>(std::max<size_t>(step - first, 1)));
+        }
+    }
+
+    return 0;
+}
+
+} // namespace Bench
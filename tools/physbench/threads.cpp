@@ -0,0 +1,80 @@
+#include "tools/physbench/bench.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "src/threadpool.h"
+
+namespace Bench
+{
+
+auto threads() -> int
+{
+    constexpr size_t steps = 120;
+    // Boxes closer than on the default grid, most of them touch a neighbour once they fall.
+    const SceneLayout layout{.entities = 20000, .spacing = 1.1f};
+
+    // 1, 2, 4... up to every worker of the pool.
+    const auto workers = ThreadPool::instance().threadsCount();
+    std::vector<size_t> counts{};
+    for (size_t count = 1; count < workers; count *= 2) {
+        counts.push_back(count);
+    }
+    counts.push_back(workers);
+
+    std::printf("%zu entities, %zu steps, %zu pool workers\n", layout.entities, steps, workers);
+    std::printf("%-8s %8s %14s %13s %10s %8s %10s\n", "threads", "batches", "candidatePairs", "narrowPhaseMs", "tickMs", "speedup", "positions");
+
+    int result = 0;
+    double referenceMs = 0.;
+    std::unique_ptr<Simulation> reference = nullptr;
+    for (const auto count : counts) {
+        auto simulation = std::make_unique<Simulation>(layout);
+        simulation->engine.setNarrowPhaseThreads(count);
+        // The static tree tests moving entities against each other pair by pair, it would hide the narrow phase.
+        simulation->engine.setBroadPhase(Physics::BroadPhase::SweepAndPrune);
+
+        // Averages over every step, the scenes must stay identical from the first one.
+        double pairs = 0.;
+        double narrowPhaseMs = 0.;
+        double tickMs = 0.;
+        for (size_t i = 0; i < steps; ++i) {
+            simulation->run(1);
+            const auto &stats = simulation->engine.stats();
+            pairs += static_cast<double>(stats.candidatePairs);
+            narrowPhaseMs += stats.narrowPhaseMs;
+            tickMs += stats.tickMs;
+        }
+
+        // The contacts are resolved in the same order whatever the threads count, the states are bit for bit equal.
+        const char *positions = "reference";
+        if (reference == nullptr) {
+            referenceMs = narrowPhaseMs;
+        } else {
+            const auto expected = reference->scene->dynamicColumn<Entity::PhysicsCartesianState>();
+            const auto states = simulation->scene->dynamicColumn<Entity::PhysicsCartesianState>();
+            const bool same = std::memcmp(expected.data(), states.data(), expected.size_bytes()) == 0;
+            positions = same ? "same" : "DIFFER";
+            result = same ? result : 1;
+        }
+
+        std::printf("%-8zu %8zu %14.0f %13.3f %10.3f %8.2f %10s\n",
+                    count,
+                    simulation->engine.stats().narrowPhaseThreads,
+                    pairs / steps,
+                    narrowPhaseMs / steps,
+                    tickMs / steps,
+                    referenceMs / narrowPhaseMs,
+                    positions);
+
+        if (reference == nullptr) {
+            reference = std::move(simulation);
+        }
+    }
+
+    return result;
+}
+
+} // namespace Bench
@@ -0,0 +1,126 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+#include "src/physics/trace.h"
+
+namespace
+{
+
+/// @brief Names of the narrow phase kernels, indexed like Physics::Stats::kernelPairs.
+constexpr std::string_view kernelNames[] = {
+    "Box-Box",
+    "Box-OrientedBox",
+    "Box-Convex",
+    "OrientedBox-Box",
+    "OrientedBox-OrientedBox",
+    "OrientedBox-Convex",
+    "Convex-Box",
+    "Convex-OrientedBox",
+    "Convex-Convex",
+};
+
+auto kernelName(const uint8_t kernel) -> std::string_view
+{
+    if (kernel == Physics::TraceRecord::noKernel) {
+        return "-";
+    }
+    return kernel < std::size(kernelNames) ? kernelNames[kernel] : "?";
+}
+
+void printText(const Physics::TraceRecord &record)
+{
+    const float overlap = record.overlap();
+    std::printf("tick %u: %d-%d %s%s axis %u of %s (%g,%g) a=[%g,%g] b=[%g,%g] overlap=%g%s\n",
+                record.tick,
+                record.a,
+                record.b,
+                record.cached ? "cached " : "",
+                kernelName(record.kernel).data(),
+                record.axis,
+                record.owner == 0 ? "a" : "b",
+                record.normalX,
+                record.normalY,
+                record.aMin,
+                record.aMax,
+                record.bMin,
+                record.bMax,
+                overlap,
+                overlap < 0.f ? " separated" : "");
+}
+
+void printCsv(const Physics::TraceRecord &record)
+{
+    std::printf("%u,%d,%d,%s,%u,%u,%u,%g,%g,%g,%g,%g,%g,%g\n",
+                record.tick,
+                record.a,
+                record.b,
+                kernelName(record.kernel).data(),
+                record.cached,
+                record.axis,
+                record.owner,
+                record.normalX,
+                record.normalY,
+                record.aMin,
+                record.aMax,
+                record.bMin,
+                record.bMax,
+                record.overlap());
+}
+
+} // namespace
+
+/**
+ * Converts a collision trace written with JUICE_COLLISION_TRACE to text, or CSV with --csv.
+ * Usage: tracedump [--csv] <trace file>
+ */
+auto main(const int argc, char **argv) -> int
+{
+    bool csv = false;
+    const char *path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    if (path == nullptr) {
+        std::cerr << "Usage: " << argv[0] << " [--csv] <trace file>\n";
+        return 1;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    Physics::TraceHeader header{};
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != Physics::TraceHeader{}.magic) {
+        std::cerr << path << " is not a collision trace\n";
+        return 1;
+    }
+    if (header.version != Physics::TraceHeader{}.version || header.recordSize != sizeof(Physics::TraceRecord)) {
+        std::cerr << path << " was written by another version, format " << header.version << '\n';
+        return 1;
+    }
+
+    if (csv) {
+        std::puts("tick,a,b,kernel,cached,axis,owner,normal_x,normal_y,a_min,a_max,b_min,b_max,overlap");
+    } else {
+        std::printf("%llu axes, %u older ones overwritten, %u dropped by crowded steps\n",
+                    static_cast<unsigned long long>(header.count),
+                    header.overwritten,
+                    header.dropped);
+    }
+
+    Physics::TraceRecord record{};
+    for (uint64_t i = 0; i < header.count && file.read(reinterpret_cast<char *>(&record), sizeof(record)); ++i) {
+        if (csv) {
+            printCsv(record);
+        } else {
+            printText(record);
+        }
+    }
+
+    return 0;
+}